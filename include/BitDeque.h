@@ -0,0 +1,187 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_BITDEQUE_H
+#define DEQUE_BITDEQUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Deque.h"
+
+// Deque of bits packed 64 to a word in a Deque<uint64_t>. headBit_ is the
+// position of the first bit inside the front word. Bits outside the stored
+// range are kept zero, so count() is a plain popcount over the words.
+class BitDeque {
+public:
+    typedef std::size_t size_type;
+
+    class reference {
+    private:
+        std::uint64_t *word_;
+        std::uint64_t mask_;
+        reference(std::uint64_t *word, std::uint64_t mask) : word_(word), mask_(mask) {}
+    public:
+        operator bool() const {
+            return (*word_ & mask_) != 0;
+        }
+
+        reference &operator =(bool value) {
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        reference &operator =(const reference &other) {
+            return *this = static_cast<bool>(other);
+        }
+
+        void flip() {
+            *word_ ^= mask_;
+        }
+
+        friend class BitDeque;
+    };
+
+private:
+    Deque<std::uint64_t> words_;
+    size_type headBit_, size_;
+
+    reference ref(size_type n) {
+        size_type pos = headBit_ + n;
+        return reference(&words_[pos / 64], std::uint64_t(1) << (pos % 64));
+    }
+
+    bool get(size_type n) const {
+        size_type pos = headBit_ + n;
+        return (words_[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    void reset_if_empty() {
+        if (size_ == 0) {
+            words_.pop_front_n(words_.size());
+            headBit_ = 0;
+        }
+    }
+
+public:
+    BitDeque() : headBit_(0), size_(0) {}
+
+    void push_back(bool value) {
+        if ((headBit_ + size_) % 64 == 0) {
+            words_.push_back(0);
+        }
+        ++size_;
+        ref(size_ - 1) = value;
+    }
+
+    void push_front(bool value) {
+        if (headBit_ == 0) {
+            words_.push_front(0);
+            headBit_ = 64;
+        }
+        --headBit_;
+        ++size_;
+        ref(0) = value;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        ref(size_ - 1) = false;
+        --size_;
+        if ((headBit_ + size_) % 64 == 0) {
+            words_.pop_back();
+        }
+        reset_if_empty();
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        ref(0) = false;
+        --size_;
+        if (++headBit_ == 64) {
+            words_.pop_front();
+            headBit_ = 0;
+        }
+        reset_if_empty();
+    }
+
+    reference operator [](size_type n) {
+        return ref(n);
+    }
+
+    bool operator [](size_type n) const {
+        return get(n);
+    }
+
+    reference front() {
+        return ref(0);
+    }
+
+    bool front() const {
+        return get(0);
+    }
+
+    reference back() {
+        return ref(size_ - 1);
+    }
+
+    bool back() const {
+        return get(size_ - 1);
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    // Number of set bits.
+    size_type count() const {
+        size_type ans = 0;
+        for (auto segment : words_.segments()) {
+            for (std::uint64_t word : segment) {
+                ans += __builtin_popcountll(word);
+            }
+        }
+        return ans;
+    }
+
+    // Index of the first set bit at or after from, size() if there is none.
+    size_type find_first(size_type from = 0) const {
+        if (from >= size_) {
+            return size_;
+        }
+        size_type pos = headBit_ + from;
+        size_type wordIndex = pos / 64;
+        std::uint64_t skip = ~std::uint64_t(0) << (pos % 64);
+        for (auto segment : words_.segments(words_.begin() + wordIndex, words_.end())) {
+            for (std::uint64_t word : segment) {
+                word &= skip;
+                skip = ~std::uint64_t(0);
+                if (word != 0) {
+                    return wordIndex * 64 + __builtin_ctzll(word) - headBit_;
+                }
+                ++wordIndex;
+            }
+        }
+        return size_;
+    }
+
+    const Deque<std::uint64_t> &words() const {
+        return words_;
+    }
+};
+
+#endif //DEQUE_BITDEQUE_H
@@ -0,0 +1,198 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_BYTEBUFFER_H
+#define DEQUE_BYTEBUFFER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "Deque.h"
+
+// I/O buffer over Deque<char> in the spirit of libevent's evbuffer. Bytes
+// are read from and written to file descriptors with readv/writev straight
+// into and out of the block buffers, without an intermediate copy.
+//
+// reserve(n) appends n uninitialized bytes and returns them as writable
+// segments; commit(k) keeps the first k of them. While a reservation is open
+// the other appending operations are not allowed.
+class ByteBuffer {
+public:
+    typedef Deque<char>::segment_range segment_range;
+
+    enum : std::size_t {
+        NPOS = SIZE_MAX,
+        MAX_IOV = 64,
+        READ_BLOCKS = 4
+    };
+private:
+    Deque<char> bytes_;
+    std::size_t reserved_;
+
+    void check_no_reservation() const {
+        if (reserved_ != 0) {
+            throw std::runtime_error("ByteBuffer has an uncommitted reservation");
+        }
+    }
+
+    template <class Range>
+    static int fill_iov(const Range &range, iovec *iov) {
+        int count = 0;
+        for (auto segment : range) {
+            if (count == MAX_IOV) {
+                break;
+            }
+            iov[count].iov_base = const_cast<char *>(segment.data());
+            iov[count].iov_len = segment.size();
+            ++count;
+        }
+        return count;
+    }
+
+public:
+    ByteBuffer() : reserved_(0) {}
+
+    std::size_t size() const {
+        return bytes_.size() - reserved_;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void append(const void *data, std::size_t n) {
+        const char *src = static_cast<const char *>(data);
+        for (auto segment : reserve(n)) {
+            std::memcpy(segment.data(), src, segment.size());
+            src += segment.size();
+        }
+        commit(n);
+    }
+
+    segment_range reserve(std::size_t n) {
+        check_no_reservation();
+        bytes_.grow_back(n);
+        reserved_ = n;
+        return bytes_.segments(bytes_.end() - n, bytes_.end());
+    }
+
+    void commit(std::size_t n) {
+        if (n > reserved_) {
+            throw std::runtime_error("Cannot commit more than was reserved");
+        }
+        bytes_.pop_back_n(reserved_ - n);
+        reserved_ = 0;
+    }
+
+    // Reads with a single readv into the free space of the last block plus
+    // at most READ_BLOCKS new blocks, and never more than max bytes, so a
+    // short read or EAGAIN allocates and frees only a few blocks. Returns
+    // what readv returned: the number of bytes appended, 0 at end of file,
+    // or -1 with errno set. With max == 0 nothing is read and 0 is returned.
+    ssize_t read_from_fd(int fd, std::size_t max = 65536) {
+        check_no_reservation();
+        if (max == 0) {
+            return 0;
+        }
+        std::size_t room = bytes_.back_capacity() + READ_BLOCKS * Deque<char>::block_size();
+        iovec iov[MAX_IOV];
+        int count = fill_iov(reserve(std::min(max, room)), iov);
+        ssize_t n = readv(fd, iov, count);
+        if (n < 0) {
+            int error = errno;
+            commit(0);
+            errno = error;
+            return n;
+        }
+        commit(static_cast<std::size_t>(n));
+        return n;
+    }
+
+    // Writes from the front with a single writev and drains what was
+    // written. Returns what writev returned.
+    ssize_t write_to_fd(int fd) {
+        check_no_reservation();
+        if (bytes_.empty()) {
+            return 0;
+        }
+        iovec iov[MAX_IOV];
+        int count = fill_iov(static_cast<const Deque<char> &>(bytes_).segments(), iov);
+        ssize_t n = writev(fd, iov, count);
+        if (n > 0) {
+            bytes_.pop_front_n(static_cast<std::size_t>(n));
+        }
+        return n;
+    }
+
+    // Copies up to n bytes from the front without removing them.
+    std::size_t peek(void *out, std::size_t n) const {
+        n = std::min(n, size());
+        char *dst = static_cast<char *>(out);
+        for (auto segment : bytes_.segments(bytes_.begin(), bytes_.begin() + n)) {
+            std::memcpy(dst, segment.data(), segment.size());
+            dst += segment.size();
+        }
+        return n;
+    }
+
+    void drain(std::size_t n) {
+        if (n > size()) {
+            throw std::runtime_error("ByteBuffer has less than n bytes");
+        }
+        bytes_.pop_front_n(n);
+    }
+
+    // Position of the first occurrence of the delimiter at or after from,
+    // NPOS if there is none. The delimiter may span blocks.
+    std::size_t find(const char *delim, std::size_t len, std::size_t from = 0) const {
+        std::size_t total = size();
+        if (len == 0 || from + len > total) {
+            return len == 0 && from <= total ? from : NPOS;
+        }
+        std::size_t offset = from;
+        for (auto segment : bytes_.segments(bytes_.begin() + from, bytes_.begin() + total)) {
+            const char *begin = segment.data(), *end = begin + segment.size();
+            for (const char *it = begin; it != end; ++it) {
+                it = static_cast<const char *>(std::memchr(it, delim[0], end - it));
+                if (it == nullptr) {
+                    break;
+                }
+                std::size_t pos = offset + (it - begin);
+                if (pos + len > total) {
+                    return NPOS;
+                }
+                std::size_t j = 1;
+                while (j < len && bytes_[pos + j] == delim[j]) {
+                    ++j;
+                }
+                if (j == len) {
+                    return pos;
+                }
+            }
+            offset += segment.size();
+        }
+        return NPOS;
+    }
+
+    std::size_t find(char delim, std::size_t from = 0) const {
+        return find(&delim, 1, from);
+    }
+
+    void clear() {
+        check_no_reservation();
+        bytes_.pop_front_n(bytes_.size());
+    }
+
+    const Deque<char> &bytes() const {
+        return bytes_;
+    }
+};
+
+#endif //DEQUE_BYTEBUFFER_H
@@ -0,0 +1,513 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_CHANNEL_H
+#define DEQUE_CHANNEL_H
+
+#if __cplusplus < 202002L
+#error "Channel.h requires C++20 coroutines"
+#endif
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Deque.h"
+
+class Executor;
+
+// Fire-and-forget coroutine. It starts suspended and runs once handed to
+// Executor::spawn(); its frame is freed when it finishes.
+class Task {
+public:
+    struct promise_type {
+        Executor *executor = nullptr;
+        // Links in the executor's list of unfinished tasks.
+        promise_type *prev = nullptr;
+        promise_type *next = nullptr;
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+
+            void await_resume() noexcept {}
+        };
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    friend class Executor;
+public:
+    Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task(const Task &) = delete;
+    Task &operator =(const Task &) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+};
+
+// Runs resumed coroutines. Channels hand waiters back through post() rather
+// than resuming them inline, so a push never runs the receiver's code.
+//
+// Executors keep the spawned tasks that have not finished and destroy their
+// frames when destroyed themselves, so tasks left suspended (e.g. on a
+// channel nobody will touch again) do not leak. Channels such tasks waited
+// on must not be used after that.
+class Executor {
+private:
+    friend struct Task::promise_type::FinalAwaiter;
+
+    Task::promise_type *live_ = nullptr;
+
+protected:
+    // Called with the task's promise; implementations must call link() and
+    // unlink() under whatever lock guards the executor.
+    virtual void task_started(Task::promise_type &promise) = 0;
+    virtual void task_finished(Task::promise_type &promise) = 0;
+
+    void link(Task::promise_type &promise) {
+        promise.next = live_;
+        if (live_ != nullptr) {
+            live_->prev = &promise;
+        }
+        live_ = &promise;
+    }
+
+    void unlink(Task::promise_type &promise) {
+        if (promise.prev != nullptr) {
+            promise.prev->next = promise.next;
+        } else {
+            live_ = promise.next;
+        }
+        if (promise.next != nullptr) {
+            promise.next->prev = promise.prev;
+        }
+    }
+
+    // For destructors: nothing may run tasks any more.
+    void destroy_unfinished() {
+        while (live_ != nullptr) {
+            Task::promise_type &promise = *live_;
+            unlink(promise);
+            std::coroutine_handle<Task::promise_type>::from_promise(promise).destroy();
+        }
+    }
+
+public:
+    virtual ~Executor() {}
+
+    virtual void post(std::coroutine_handle<> handle) = 0;
+
+    void spawn(Task task) {
+        auto handle = std::exchange(task.handle_, nullptr);
+        handle.promise().executor = this;
+        task_started(handle.promise());
+        post(handle);
+    }
+};
+
+inline void Task::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    handle.promise().executor->task_finished(handle.promise());
+    handle.destroy();
+}
+
+// Runs everything on the thread calling run(); post() must come from that
+// thread too.
+class SingleThreadExecutor : public Executor {
+private:
+    Deque<std::coroutine_handle<>> ready_;
+    std::size_t tasks_ = 0;
+
+protected:
+    void task_started(Task::promise_type &promise) override {
+        ++tasks_;
+        link(promise);
+    }
+
+    void task_finished(Task::promise_type &promise) override {
+        --tasks_;
+        unlink(promise);
+    }
+
+public:
+    ~SingleThreadExecutor() override {
+        destroy_unfinished();
+    }
+
+    void post(std::coroutine_handle<> handle) override {
+        ready_.push_back(handle);
+    }
+
+    // Runs until nothing is ready. Returns the number of spawned tasks that
+    // are still suspended; their frames live until the executor is
+    // destroyed.
+    std::size_t run() {
+        while (!ready_.empty()) {
+            auto handle = ready_.front();
+            ready_.pop_front();
+            handle.resume();
+        }
+        return tasks_;
+    }
+};
+
+// Pool of worker threads sharing one ready queue. post() may be called from
+// any thread.
+class ThreadSafeExecutor : public Executor {
+private:
+    std::mutex mutex_;
+    std::condition_variable readyCv_, idleCv_;
+    Deque<std::coroutine_handle<>> ready_;
+    std::vector<std::thread> workers_;
+    std::size_t tasks_ = 0;
+    bool stopping_ = false;
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            readyCv_.wait(lock, [this]() {
+                return stopping_ || !ready_.empty();
+            });
+            if (ready_.empty()) {
+                return;
+            }
+            auto handle = ready_.front();
+            ready_.pop_front();
+            lock.unlock();
+            handle.resume();
+            lock.lock();
+        }
+    }
+
+protected:
+    void task_started(Task::promise_type &promise) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++tasks_;
+        link(promise);
+    }
+
+    void task_finished(Task::promise_type &promise) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        unlink(promise);
+        if (--tasks_ == 0) {
+            idleCv_.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadSafeExecutor(std::size_t threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) {
+            threads = 1;
+        }
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() {
+                work();
+            });
+        }
+    }
+
+    ThreadSafeExecutor(const ThreadSafeExecutor &) = delete;
+    ThreadSafeExecutor &operator =(const ThreadSafeExecutor &) = delete;
+
+    ~ThreadSafeExecutor() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        readyCv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+        destroy_unfinished();
+    }
+
+    void post(std::coroutine_handle<> handle) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(handle);
+        }
+        readyCv_.notify_one();
+    }
+
+    // Blocks until every spawned task has finished.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idleCv_.wait(lock, [this]() {
+            return tasks_ == 0;
+        });
+    }
+};
+
+// Bounded multi-producer/multi-consumer channel for coroutines:
+//   bool ok = co_await channel.push(value);        // false once closed
+//   std::optional<T> value = co_await channel.pop(); // nullopt once closed and drained
+//   std::vector<T> batch = co_await channel.pop_batch(64);
+// push suspends while the channel is full and pop while it is empty.
+// Values are buffered in a Deque, and a push meeting a suspended receiver
+// hands the value over directly. Suspended coroutines are resumed through
+// the channel's executor.
+template <class T>
+class Channel {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    static constexpr size_type UNBOUNDED = std::numeric_limits<size_type>::max();
+private:
+    struct Sender {
+        std::coroutine_handle<> handle;
+        T value;
+        bool accepted;
+    };
+
+    struct Receiver {
+        std::coroutine_handle<> handle;
+        std::optional<T> value;
+    };
+
+    Executor &executor_;
+    size_type capacity_;
+    std::mutex mutex_;
+    Deque<T> buffer_;
+    Deque<Sender *> senders_;
+    Deque<Receiver *> receivers_;
+    bool closed_;
+
+    // Moves values of suspended senders into the freed space.
+    void refill() {
+        while (!senders_.empty() && buffer_.size() < capacity_) {
+            Sender *sender = senders_.front();
+            senders_.pop_front();
+            buffer_.push_back(std::move(sender->value));
+            sender->accepted = true;
+            executor_.post(sender->handle);
+        }
+    }
+
+    // Stores value or hands it to a waiting receiver; false if full.
+    bool offer(T &value) {
+        if (!receivers_.empty()) {
+            Receiver *receiver = receivers_.front();
+            receivers_.pop_front();
+            receiver->value.emplace(std::move(value));
+            executor_.post(receiver->handle);
+            return true;
+        }
+        if (buffer_.size() < capacity_) {
+            buffer_.push_back(std::move(value));
+            return true;
+        }
+        return false;
+    }
+
+    bool take(std::optional<T> &out) {
+        if (buffer_.empty()) {
+            return false;
+        }
+        out.emplace(std::move(buffer_.front()));
+        buffer_.pop_front();
+        refill();
+        return true;
+    }
+
+public:
+    class PushAwaiter {
+    private:
+        Channel &channel_;
+        Sender sender_;
+    public:
+        PushAwaiter(Channel &channel, T value) : channel_(channel), sender_{nullptr, std::move(value), false} {}
+
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(channel_.mutex_);
+            if (channel_.closed_) {
+                return false;
+            }
+            if (channel_.offer(sender_.value)) {
+                sender_.accepted = true;
+                return false;
+            }
+            sender_.handle = handle;
+            channel_.senders_.push_back(&sender_);
+            return true;
+        }
+
+        bool await_resume() {
+            return sender_.accepted;
+        }
+    };
+
+    class PopAwaiter {
+    private:
+        Channel &channel_;
+        Receiver receiver_;
+    public:
+        explicit PopAwaiter(Channel &channel) : channel_(channel), receiver_{nullptr, std::nullopt} {}
+
+        bool await_ready() {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(channel_.mutex_);
+            if (channel_.take(receiver_.value) || channel_.closed_) {
+                return false;
+            }
+            receiver_.handle = handle;
+            channel_.receivers_.push_back(&receiver_);
+            return true;
+        }
+
+        std::optional<T> await_resume() {
+            return std::move(receiver_.value);
+        }
+    };
+
+    // Waits for at least one value and takes up to max buffered ones under a
+    // single lock acquisition.
+    class BatchAwaiter {
+    private:
+        Channel &channel_;
+        Receiver receiver_;
+        size_type max_;
+        std::vector<T> batch_;
+
+        void drain() {
+            while (batch_.size() < max_ && !channel_.buffer_.empty()) {
+                batch_.push_back(std::move(channel_.buffer_.front()));
+                channel_.buffer_.pop_front();
+            }
+            channel_.refill();
+        }
+    public:
+        BatchAwaiter(Channel &channel, size_type max) : channel_(channel), receiver_{nullptr, std::nullopt}, max_(max) {}
+
+        bool await_ready() {
+            return max_ == 0;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> lock(channel_.mutex_);
+            drain();
+            if (!batch_.empty() || channel_.closed_) {
+                return false;
+            }
+            receiver_.handle = handle;
+            channel_.receivers_.push_back(&receiver_);
+            return true;
+        }
+
+        std::vector<T> await_resume() {
+            if (receiver_.value) {
+                batch_.push_back(std::move(*receiver_.value));
+                std::lock_guard<std::mutex> lock(channel_.mutex_);
+                drain();
+            }
+            return std::move(batch_);
+        }
+    };
+
+    explicit Channel(Executor &executor, size_type capacity = UNBOUNDED) :
+            executor_(executor),
+            capacity_(capacity),
+            closed_(false) {
+        if (capacity == 0) {
+            throw std::runtime_error("Channel capacity must be positive");
+        }
+    }
+
+    Channel(const Channel &) = delete;
+    Channel &operator =(const Channel &) = delete;
+
+    PushAwaiter push(T value) {
+        return PushAwaiter(*this, std::move(value));
+    }
+
+    PopAwaiter pop() {
+        return PopAwaiter(*this);
+    }
+
+    BatchAwaiter pop_batch(size_type max) {
+        return BatchAwaiter(*this, max);
+    }
+
+    // Non-suspending variants for code outside coroutines.
+    bool try_push(T value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !closed_ && offer(value);
+    }
+
+    std::optional<T> try_pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::optional<T> ans;
+        take(ans);
+        return ans;
+    }
+
+    // Fails pending and future pushes; receivers drain what is buffered and
+    // then get nullopt (an empty batch).
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        while (!senders_.empty()) {
+            executor_.post(senders_.front()->handle);
+            senders_.pop_front();
+        }
+        while (!receivers_.empty()) {
+            executor_.post(receivers_.front()->handle);
+            receivers_.pop_front();
+        }
+    }
+
+    bool closed() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    size_type size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffer_.size();
+    }
+};
+
+#endif //DEQUE_CHANNEL_H
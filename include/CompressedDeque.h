@@ -0,0 +1,235 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_COMPRESSEDDEQUE_H
+#define DEQUE_COMPRESSEDDEQUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Deque.h"
+
+// Deque of int64_t (e.g. timestamps) that keeps its interior compressed.
+// The ends are plain Deques, so push and pop never touch compressed data
+// except when an end runs dry and takes a chunk back. Every interior chunk
+// holds exactly CHUNK values as zigzag varints of the deltas between
+// neighbours. Reads from the interior decode a whole chunk into a small
+// round-robin cache.
+//
+// Because that cache is updated by const reads, operator[] const is not safe
+// to call from several threads at once, unlike on standard containers.
+// Concurrent readers need their own copies or external locking.
+class CompressedDeque {
+public:
+    typedef std::int64_t value_type;
+    typedef std::size_t size_type;
+
+    enum : std::size_t {
+        CHUNK = 128,
+        CACHE_SIZE = 4
+    };
+private:
+    struct CacheEntry {
+        std::uint64_t id;
+        bool valid;
+        std::int64_t values[CHUNK];
+    };
+
+    Deque<std::int64_t> head_, tail_;
+    Deque<std::vector<std::uint8_t>> chunks_;
+    // Id of chunks_.front(); ids stay attached to a chunk while the ends move.
+    std::uint64_t firstId_;
+    size_type compressedBytes_;
+    mutable CacheEntry cache_[CACHE_SIZE];
+    mutable size_type nextVictim_;
+
+    static std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    static std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    template <class Source>
+    static std::vector<std::uint8_t> encode(const Source &source, size_type first) {
+        std::uint8_t buffer[CHUNK * 10];
+        std::uint8_t *out = buffer;
+        std::int64_t prev = 0;
+        for (size_type i = 0; i < CHUNK; ++i) {
+            std::int64_t value = source[first + i];
+            std::uint64_t word = zigzag(static_cast<std::int64_t>(static_cast<std::uint64_t>(value) -
+                                                                  static_cast<std::uint64_t>(prev)));
+            while (word >= 0x80) {
+                *out++ = static_cast<std::uint8_t>(word | 0x80);
+                word >>= 7;
+            }
+            *out++ = static_cast<std::uint8_t>(word);
+            prev = value;
+        }
+        return std::vector<std::uint8_t>(buffer, out);
+    }
+
+    static void decode(const std::vector<std::uint8_t> &bytes, std::int64_t *values) {
+        const std::uint8_t *in = bytes.data();
+        std::uint64_t prev = 0;
+        for (size_type i = 0; i < CHUNK; ++i) {
+            std::uint64_t word = 0;
+            int shift = 0;
+            while (*in & 0x80) {
+                word |= static_cast<std::uint64_t>(*in++ & 0x7f) << shift;
+                shift += 7;
+            }
+            word |= static_cast<std::uint64_t>(*in++) << shift;
+            prev += static_cast<std::uint64_t>(unzigzag(word));
+            values[i] = static_cast<std::int64_t>(prev);
+        }
+    }
+
+    const std::int64_t *chunk_values(size_type index) const {
+        std::uint64_t id = firstId_ + index;
+        for (auto &entry : cache_) {
+            if (entry.valid && entry.id == id) {
+                return entry.values;
+            }
+        }
+        CacheEntry &entry = cache_[nextVictim_];
+        nextVictim_ = (nextVictim_ + 1) % CACHE_SIZE;
+        decode(chunks_[index], entry.values);
+        entry.id = id;
+        entry.valid = true;
+        return entry.values;
+    }
+
+    void forget(std::uint64_t id) {
+        for (auto &entry : cache_) {
+            if (entry.id == id) {
+                entry.valid = false;
+            }
+        }
+    }
+
+    // Moves CHUNK values between an end and the compressed interior.
+    void compress_tail() {
+        chunks_.push_back(encode(tail_, 0));
+        compressedBytes_ += chunks_.back().size();
+        tail_.pop_front_n(CHUNK);
+    }
+
+    void compress_head() {
+        chunks_.push_front(encode(head_, head_.size() - CHUNK));
+        compressedBytes_ += chunks_.front().size();
+        --firstId_;
+        forget(firstId_);
+        head_.pop_back_n(CHUNK);
+    }
+
+    void refill_head() {
+        std::int64_t values[CHUNK];
+        decode(chunks_.front(), values);
+        for (size_type i = CHUNK; i-- > 0;) {
+            head_.push_front(values[i]);
+        }
+        compressedBytes_ -= chunks_.front().size();
+        forget(firstId_);
+        chunks_.pop_front();
+        ++firstId_;
+    }
+
+    void refill_tail() {
+        std::int64_t values[CHUNK];
+        decode(chunks_.back(), values);
+        for (size_type i = 0; i < CHUNK; ++i) {
+            tail_.push_back(values[i]);
+        }
+        compressedBytes_ -= chunks_.back().size();
+        forget(firstId_ + chunks_.size() - 1);
+        chunks_.pop_back();
+    }
+
+public:
+    CompressedDeque() : firstId_(0), compressedBytes_(0), nextVictim_(0) {
+        for (auto &entry : cache_) {
+            entry.valid = false;
+        }
+    }
+
+    void push_back(std::int64_t value) {
+        tail_.push_back(value);
+        if (tail_.size() == 2 * CHUNK) {
+            compress_tail();
+        }
+    }
+
+    void push_front(std::int64_t value) {
+        head_.push_front(value);
+        if (head_.size() == 2 * CHUNK) {
+            compress_head();
+        }
+    }
+
+    void pop_front() {
+        if (head_.empty() && !chunks_.empty()) {
+            refill_head();
+        }
+        if (!head_.empty()) {
+            head_.pop_front();
+        } else if (!tail_.empty()) {
+            tail_.pop_front();
+        } else {
+            throw std::runtime_error("Deque is already empty");
+        }
+    }
+
+    void pop_back() {
+        if (tail_.empty() && !chunks_.empty()) {
+            refill_tail();
+        }
+        if (!tail_.empty()) {
+            tail_.pop_back();
+        } else if (!head_.empty()) {
+            head_.pop_back();
+        } else {
+            throw std::runtime_error("Deque is already empty");
+        }
+    }
+
+    // Not thread-safe even though const: it updates the chunk cache.
+    std::int64_t operator [](size_type n) const {
+        if (n < head_.size()) {
+            return head_[n];
+        }
+        n -= head_.size();
+        if (n < chunks_.size() * CHUNK) {
+            return chunk_values(n / CHUNK)[n % CHUNK];
+        }
+        return tail_[n - chunks_.size() * CHUNK];
+    }
+
+    std::int64_t front() const {
+        return (*this)[0];
+    }
+
+    std::int64_t back() const {
+        return (*this)[size() - 1];
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_type size() const {
+        return head_.size() + chunks_.size() * CHUNK + tail_.size();
+    }
+
+    // Bytes held for the elements: raw ends, encoded chunks and their headers.
+    size_type memory_bytes() const {
+        return (head_.size() + tail_.size()) * sizeof(std::int64_t) + compressedBytes_ +
+               chunks_.size() * sizeof(std::vector<std::uint8_t>);
+    }
+};
+
+#endif //DEQUE_COMPRESSEDDEQUE_H
@@ -0,0 +1,448 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_CONCURRENTDEQUE_H
+#define DEQUE_CONCURRENTDEQUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Deque for one writer thread and any number of concurrent readers. The
+// writer never waits for readers; readers take no locks.
+//
+// Elements live in blocks found through a power-of-two ring of block
+// pointers (the map), addressed by free-running positions: head_ is the
+// position of the front element, tail_ one past the back. Blocks and maps
+// that the writer drops are retired and freed only once every reader that
+// might still hold them has left (epoch-based reclamation).
+//
+// A reader copies an element and then validates the copy: the position must
+// still lie in [head_, tail_), and rewrites_ must not have changed. rewrites_
+// is a sequence counter bumped around the only writes that can hit a
+// position readers may be looking at: a push into a position that was
+// published before and has been popped since. Appending at the back and
+// popping at the front, the usual queue pattern, never bump it.
+template <class T>
+class ConcurrentDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ConcurrentDeque requires trivially copyable elements");
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    enum : std::size_t {
+        MAX_READERS = 64
+    };
+private:
+    static constexpr std::size_t floor_pow2(std::size_t n, std::size_t p = 1) {
+        return 2 * p > n ? p : floor_pow2(n, 2 * p);
+    }
+
+    // A power of two, so that block numbers stay contiguous when positions
+    // wrap around.
+    static constexpr std::size_t BLOCK_SIZE = floor_pow2(1024 / sizeof(T)) >= 4 ? floor_pow2(1024 / sizeof(T)) : 4;
+
+    struct Map {
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T *>[]> blocks;
+
+        explicit Map(std::size_t capacity) : mask(capacity - 1), blocks(new std::atomic<T *>[capacity]) {
+            for (std::size_t i = 0; i < capacity; ++i) {
+                blocks[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<T *> &slot(std::uint64_t block) {
+            return blocks[block & mask];
+        }
+    };
+
+    struct alignas(64) ReaderSlot {
+        std::atomic<bool> claimed;
+        std::atomic<std::uint64_t> epoch;
+    };
+
+    struct Retired {
+        void *ptr;
+        void (*free)(void *);
+        std::uint64_t epoch;
+    };
+
+    static const std::uint64_t INACTIVE = ~std::uint64_t(0);
+    static const std::size_t RECLAIM_BATCH = 16;
+
+    // Written by the writer, read by everyone.
+    alignas(64) std::atomic<std::uint64_t> head_;
+    std::atomic<std::uint64_t> tail_;
+    std::atomic<Map *> map_;
+    alignas(64) std::atomic<std::uint64_t> rewrites_;
+    alignas(64) std::atomic<std::uint64_t> epoch_;
+    mutable ReaderSlot readers_[MAX_READERS];
+
+    // Writer only. [minHead_, maxTail_) covers every position ever published.
+    std::uint64_t minHead_, maxTail_;
+    std::size_t blocksCount_;
+    std::vector<Retired> retired_;
+
+    static std::uint64_t block_of(std::uint64_t pos) {
+        return pos / BLOCK_SIZE;
+    }
+
+    static T *new_block() {
+        return static_cast<T *>(::operator new(BLOCK_SIZE * sizeof(T)));
+    }
+
+    static void free_block(void *ptr) {
+        ::operator delete(ptr);
+    }
+
+    static void free_map(void *ptr) {
+        delete static_cast<Map *>(ptr);
+    }
+
+    void retire(void *ptr, void (*free)(void *)) {
+        retired_.push_back(Retired{ptr, free, epoch_.load(std::memory_order_relaxed)});
+        if (retired_.size() >= RECLAIM_BATCH) {
+            reclaim();
+        }
+    }
+
+    // Frees what was retired before the oldest epoch any active reader
+    // announced. The seq_cst increment pairs with the acquire load in
+    // enter(): a reader announcing the new epoch also sees every unlink
+    // retired under the old one.
+    void reclaim() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t oldest = INACTIVE;
+        for (auto &reader : readers_) {
+            oldest = std::min(oldest, reader.epoch.load(std::memory_order_relaxed));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::size_t kept = 0;
+        for (auto &item : retired_) {
+            if (item.epoch < oldest) {
+                item.free(item.ptr);
+            } else {
+                retired_[kept++] = item;
+            }
+        }
+        retired_.resize(kept);
+    }
+
+    bool published_before(std::uint64_t pos) const {
+        return pos - minHead_ < maxTail_ - minHead_;
+    }
+
+    // Makes sure the block of pos exists; it is a new block at one end.
+    void ensure_block(std::uint64_t pos, bool atBack) {
+        Map *map = map_.load(std::memory_order_relaxed);
+        if (blocksCount_ == map->mask + 1) {
+            Map *bigger = new Map(2 * (map->mask + 1));
+            std::uint64_t first = atBack ? block_of(head_.load(std::memory_order_relaxed)) : block_of(pos) + 1;
+            for (std::size_t i = 0; i < blocksCount_; ++i) {
+                bigger->slot(first + i).store(map->slot(first + i).load(std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+            }
+            map_.store(bigger, std::memory_order_release);
+            retire(map, free_map);
+            map = bigger;
+        }
+        map->slot(block_of(pos)).store(new_block(), std::memory_order_release);
+        ++blocksCount_;
+    }
+
+    // The slot is cleared so that a stale map never hands out the block
+    // after it is freed.
+    void drop_block(std::uint64_t pos) {
+        Map *map = map_.load(std::memory_order_relaxed);
+        T *block = map->slot(block_of(pos)).load(std::memory_order_relaxed);
+        map->slot(block_of(pos)).store(nullptr, std::memory_order_release);
+        retire(block, free_block);
+        --blocksCount_;
+    }
+
+    void write(std::uint64_t pos, const T &value) {
+        T *block = map_.load(std::memory_order_relaxed)->slot(block_of(pos)).load(std::memory_order_relaxed);
+        if (published_before(pos)) {
+            std::uint64_t seq = rewrites_.load(std::memory_order_relaxed);
+            rewrites_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(static_cast<void *>(block + pos % BLOCK_SIZE), &value, sizeof(T));
+            rewrites_.store(seq + 2, std::memory_order_release);
+        } else {
+            std::memcpy(static_cast<void *>(block + pos % BLOCK_SIZE), &value, sizeof(T));
+        }
+    }
+
+    void enter(std::size_t slot) const {
+        readers_[slot].epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void leave(std::size_t slot) const {
+        readers_[slot].epoch.store(INACTIVE, std::memory_order_release);
+    }
+
+    // Copies [first, first + n), which lies in one block, into out. Returns
+    // false if the copy has to be repeated; otherwise valid is set to the
+    // part of the range that was still in the deque when the copy ended.
+    bool read_run(std::uint64_t first, std::size_t n, T *out,
+                  std::pair<std::uint64_t, std::uint64_t> &valid) const {
+        std::uint64_t seq = rewrites_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            return false;
+        }
+        Map *map = map_.load(std::memory_order_acquire);
+        T *block = map->slot(block_of(first)).load(std::memory_order_acquire);
+        if (block != nullptr) {
+            std::memcpy(static_cast<void *>(out), block + first % BLOCK_SIZE, n * sizeof(T));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Acquire keeps the rewrites_ check below after these loads.
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        std::uint64_t tail = tail_.load(std::memory_order_acquire);
+        if (rewrites_.load(std::memory_order_relaxed) != seq) {
+            return false;
+        }
+        // Intersect with [head, tail) by signed distance from head, which
+        // orders positions correctly even when the counters wrap.
+        std::int64_t begin = static_cast<std::int64_t>(first - head);
+        std::int64_t end = begin + static_cast<std::int64_t>(n);
+        begin = std::max<std::int64_t>(begin, 0);
+        end = std::min<std::int64_t>(end, static_cast<std::int64_t>(tail - head));
+        if (begin >= end) {
+            valid = std::make_pair(first, first);
+            return true;
+        }
+        if (block == nullptr) {
+            return false;
+        }
+        valid = std::make_pair(head + begin, head + end);
+        return true;
+    }
+
+    bool read(std::size_t slot, bool fromBack, size_type n, T &out) const {
+        enter(slot);
+        bool found = false;
+        while (true) {
+            std::uint64_t head = head_.load(std::memory_order_acquire);
+            std::uint64_t tail = tail_.load(std::memory_order_acquire);
+            if (n >= tail - head) {
+                break;
+            }
+            std::uint64_t pos = fromBack ? tail - 1 - n : head + n;
+            std::pair<std::uint64_t, std::uint64_t> valid;
+            if (read_run(pos, 1, &out, valid) && valid.first != valid.second) {
+                found = true;
+                break;
+            }
+        }
+        leave(slot);
+        return found;
+    }
+
+public:
+    // Per-thread reading handle; each concurrently used one takes one of
+    // MAX_READERS slots.
+    class Reader {
+    private:
+        const ConcurrentDeque *deque_;
+        std::size_t slot_;
+        Reader(const ConcurrentDeque *deque, std::size_t slot) : deque_(deque), slot_(slot) {}
+    public:
+        Reader(Reader &&other) : deque_(other.deque_), slot_(other.slot_) {
+            other.deque_ = nullptr;
+        }
+
+        Reader(const Reader &) = delete;
+        Reader &operator =(const Reader &) = delete;
+
+        ~Reader() {
+            if (deque_ != nullptr) {
+                deque_->readers_[slot_].claimed.store(false, std::memory_order_release);
+            }
+        }
+
+        // Copies the n-th element from the front (back) into out; false if
+        // there is no such element.
+        bool get(size_type n, T &out) const {
+            return deque_->read(slot_, false, n, out);
+        }
+
+        bool get_from_back(size_type n, T &out) const {
+            return deque_->read(slot_, true, n, out);
+        }
+
+        bool front(T &out) const {
+            return get(0, out);
+        }
+
+        bool back(T &out) const {
+            return get_from_back(0, out);
+        }
+
+        size_type size() const {
+            return deque_->size();
+        }
+
+        // Calls f on copies of the elements from the front, one block at a
+        // time. Elements popped before their block is read are skipped;
+        // elements pushed after the call started are not visited.
+        template <class Function>
+        void for_each(Function f) const {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[BLOCK_SIZE];
+            T *buffer = reinterpret_cast<T *>(storage);
+            deque_->enter(slot_);
+            std::uint64_t pos = deque_->head_.load(std::memory_order_acquire);
+            std::uint64_t last = deque_->tail_.load(std::memory_order_acquire);
+            while (pos != last) {
+                std::size_t n = std::min<std::uint64_t>(last - pos, BLOCK_SIZE - pos % BLOCK_SIZE);
+                std::pair<std::uint64_t, std::uint64_t> valid;
+                if (!deque_->read_run(pos, n, buffer, valid)) {
+                    continue;
+                }
+                for (std::uint64_t it = valid.first; it != valid.second; ++it) {
+                    f(static_cast<const T &>(buffer[it - pos]));
+                }
+                pos += n;
+            }
+            deque_->leave(slot_);
+        }
+
+        friend class ConcurrentDeque;
+    };
+
+    ConcurrentDeque() :
+            head_(0),
+            tail_(0),
+            map_(new Map(4)),
+            rewrites_(0),
+            epoch_(0),
+            minHead_(0),
+            maxTail_(0),
+            blocksCount_(0) {
+        for (auto &reader : readers_) {
+            reader.claimed.store(false, std::memory_order_relaxed);
+            reader.epoch.store(INACTIVE, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentDeque(const ConcurrentDeque &) = delete;
+    ConcurrentDeque &operator =(const ConcurrentDeque &) = delete;
+
+    // No reader may be active any more.
+    ~ConcurrentDeque() {
+        for (auto &item : retired_) {
+            item.free(item.ptr);
+        }
+        Map *map = map_.load(std::memory_order_relaxed);
+        if (blocksCount_ != 0) {
+            std::uint64_t first = block_of(head_.load(std::memory_order_relaxed));
+            for (std::size_t i = 0; i < blocksCount_; ++i) {
+                free_block(map->slot(first + i).load(std::memory_order_relaxed));
+            }
+        }
+        delete map;
+    }
+
+    Reader reader() const {
+        for (std::size_t i = 0; i < MAX_READERS; ++i) {
+            bool expected = false;
+            if (readers_[i].claimed.compare_exchange_strong(expected, true)) {
+                return Reader(this, i);
+            }
+        }
+        throw std::runtime_error("Too many concurrent readers");
+    }
+
+    size_type size() const {
+        while (true) {
+            std::uint64_t head = head_.load(std::memory_order_acquire);
+            std::uint64_t tail = tail_.load(std::memory_order_acquire);
+            if (head_.load(std::memory_order_relaxed) == head) {
+                return tail - head;
+            }
+        }
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Writer side; must be called from a single thread.
+    void push_back(const T &value) {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (head == tail || tail % BLOCK_SIZE == 0) {
+            ensure_block(tail, true);
+        }
+        write(tail, value);
+        tail_.store(tail + 1, std::memory_order_release);
+        if (!published_before(tail)) {
+            if (maxTail_ == minHead_) {
+                minHead_ = tail;
+            }
+            maxTail_ = tail + 1;
+        }
+    }
+
+    void push_front(const T &value) {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (head == tail || head % BLOCK_SIZE == 0) {
+            ensure_block(head - 1, false);
+        }
+        write(head - 1, value);
+        head_.store(head - 1, std::memory_order_release);
+        if (!published_before(head - 1)) {
+            if (maxTail_ == minHead_) {
+                maxTail_ = head;
+            }
+            minHead_ = head - 1;
+        }
+    }
+
+    void pop_back() {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (head == tail) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        tail_.store(tail - 1, std::memory_order_release);
+        if (head == tail - 1 || (tail - 1) % BLOCK_SIZE == 0) {
+            drop_block(tail - 1);
+        }
+    }
+
+    void pop_front() {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (head == tail) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        head_.store(head + 1, std::memory_order_release);
+        if (head + 1 == tail || (head + 1) % BLOCK_SIZE == 0) {
+            drop_block(head);
+        }
+    }
+};
+
+template <class T>
+constexpr std::size_t ConcurrentDeque<T>::BLOCK_SIZE;
+
+template <class T>
+const std::uint64_t ConcurrentDeque<T>::INACTIVE;
+
+template <class T>
+const std::size_t ConcurrentDeque<T>::RECLAIM_BATCH;
+
+#endif //DEQUE_CONCURRENTDEQUE_H
@@ -10,6 +10,12 @@
 #include <iterator>
 #include <memory>
 #include <exception>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "RingBuffer.h"
 
@@ -18,14 +24,22 @@ class Deque {
 public:
     typedef T value_type;
     typedef Allocator allocator_type;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef typename std::allocator_traits<Allocator>::pointer pointer;
+    typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
     typedef std::size_t size_type;
 private:
+#if __cplusplus >= 201703L && defined(__GNUC__)
+// std::iterator is deprecated since C++17; the base only supplies typedefs.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
     template <class IterType, class RefType, class PtrType, class DequeType>
     class DequeIterator : public std::iterator<std::random_access_iterator_tag, IterType> {
+#if __cplusplus >= 201703L && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
     public:
         typedef std::ptrdiff_t difference_type;
     private:
@@ -143,6 +157,116 @@ private:
         friend DequeType;
     };
 
+    template <class PtrType>
+    class Segment {
+    private:
+        PtrType data_;
+        size_type size_;
+    public:
+        Segment() : data_(nullptr), size_(0) {}
+        Segment(PtrType data, size_type size) : data_(data), size_(size) {}
+
+        PtrType data() const {
+            return data_;
+        }
+
+        size_type size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        PtrType begin() const {
+            return data_;
+        }
+
+        PtrType end() const {
+            return data_ + size_;
+        }
+    };
+
+#if __cplusplus >= 201703L && defined(__GNUC__)
+// std::iterator is deprecated since C++17; the base only supplies typedefs.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    template <class SegmentType, class DequeType>
+    class SegmentIterator : public std::iterator<std::forward_iterator_tag, SegmentType,
+            std::ptrdiff_t, const SegmentType *, SegmentType> {
+#if __cplusplus >= 201703L && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    private:
+        size_type n_, last_;
+        DequeType *deque_;
+        SegmentIterator(size_type n, size_type last, DequeType *deque) :
+                n_(n), last_(last), deque_(deque)
+        {}
+    public:
+        SegmentIterator() : n_(0), last_(0), deque_(nullptr) {}
+
+        bool operator ==(const SegmentIterator &other) const {
+            return deque_ == other.deque_ && n_ == other.n_;
+        }
+
+        bool operator !=(const SegmentIterator &other) const {
+            return !operator==(other);
+        }
+
+        SegmentType operator *() const {
+            auto p = deque_->get_item_index(n_);
+            DataBlock *block = deque_->current_[p.first];
+            size_type available = block->end - (block->buffer + p.second);
+            return SegmentType(block->buffer + p.second, std::min(available, last_ - n_));
+        }
+
+        SegmentIterator &operator ++() {
+            n_ += (**this).size();
+            return *this;
+        }
+
+        const SegmentIterator operator ++(int) {
+            SegmentIterator ans = *this;
+            ++(*this);
+            return ans;
+        }
+        friend DequeType;
+    };
+
+    template <class SegmentType, class DequeType>
+    class SegmentRange {
+    public:
+        typedef SegmentIterator<SegmentType, DequeType> iterator;
+    private:
+        size_type first_, last_;
+        DequeType *deque_;
+        SegmentRange(size_type first, size_type last, DequeType *deque) :
+                first_(first), last_(last), deque_(deque)
+        {}
+    public:
+        iterator begin() const {
+            return iterator(first_, last_, deque_);
+        }
+
+        iterator end() const {
+            return iterator(last_, last_, deque_);
+        }
+
+        bool empty() const {
+            return first_ == last_;
+        }
+
+        size_type size() const {
+            if (empty()) {
+                return 0;
+            }
+            return deque_->get_item_index(last_ - 1).first - deque_->get_item_index(first_).first + 1;
+        }
+        friend DequeType;
+    };
+
     struct DataBlock {
         static const std::size_t SIZE = MAX(4ul, 1024 / sizeof(T));
         pointer buffer, begin, end;
@@ -172,9 +296,15 @@ private:
         }
     };
 
-    RingBuffer<DataBlock *> current_;
-    mutable RingBuffer<DataBlock *> small_, big_;
+    typedef std::allocator_traits<Allocator> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<DataBlock> BlockAllocator;
+    typedef std::allocator_traits<BlockAllocator> BlockAllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<DataBlock *> MapAllocator;
+    typedef RingBuffer<DataBlock *, MapAllocator> BlockMap;
+
     Allocator allocator_;
+    BlockMap current_;
+    mutable BlockMap small_, big_;
 
     bool small_up_to_date() const {
         return small_.full() || small_.size() == current_.size();
@@ -204,6 +334,16 @@ private:
         big_overtake();
     }
 
+    void grow() {
+        if (current_.max_size() == 0) {
+            small_.reset_and_resize(MIN_BUFFER_SIZE);
+            current_.reset_and_resize(MIN_BUFFER_SIZE * 2);
+            big_.reset_and_resize(MIN_BUFFER_SIZE * 4);
+        } else {
+            level_up();
+        }
+    }
+
     void level_up() {
         current_.swap(small_);
         current_.swap(big_);
@@ -219,28 +359,154 @@ private:
         small_.reset_and_resize(current_.max_size() / 2);
     }
 
+    DataBlock *create_block(bool fillFromEnd) {
+        pointer ptr = AllocTraits::allocate(allocator_, DataBlock::SIZE);
+        BlockAllocator blockAllocator(allocator_);
+        DataBlock *block;
+        try {
+            block = BlockAllocTraits::allocate(blockAllocator, 1);
+        } catch (...) {
+            AllocTraits::deallocate(allocator_, ptr, DataBlock::SIZE);
+            throw;
+        }
+        BlockAllocTraits::construct(blockAllocator, block, ptr, fillFromEnd);
+        return block;
+    }
+
+    void destroy_block(DataBlock *block) {
+        for (pointer it = block->begin; it != block->end; ++it) {
+            AllocTraits::destroy(allocator_, it);
+        }
+        AllocTraits::deallocate(allocator_, block->buffer, DataBlock::SIZE);
+        BlockAllocator blockAllocator(allocator_);
+        BlockAllocTraits::destroy(blockAllocator, block);
+        BlockAllocTraits::deallocate(blockAllocator, block, 1);
+    }
+
+    void prepare_back_block() {
+        if (current_.empty() || !current_.back()->can_push_back()) {
+            if (current_.full()) {
+                grow();
+            }
+            DataBlock *block = create_block(false);
+            current_.push_back(block);
+            if (!small_.full()) {
+                small_.push_back(block);
+            }
+        }
+        overtake();
+    }
+
+    void prepare_front_block() {
+        if (current_.empty() || !current_.front()->can_push_front()) {
+            if (current_.full()) {
+                grow();
+            }
+            DataBlock *block = create_block(true);
+            current_.push_front(block);
+            big_.push_front(block);
+            if (small_.full()) {
+                small_.pop_back();
+            }
+            small_.push_front(block);
+        }
+        overtake();
+    }
+
+    void construct_back(DataBlock *block, size_type n, std::true_type) {
+        block->end += n;
+    }
+
+    void construct_back(DataBlock *block, size_type n, std::false_type) {
+        for (; n != 0; --n) {
+            AllocTraits::construct(allocator_, block->end);
+            ++block->end;
+        }
+    }
+
+    // Unlinks the first (last) block from all three maps and destroys it
+    // together with any elements still in it.
+    void release_front_block() {
+        DataBlock *block = current_.front();
+        if (!big_.empty()) {
+            big_.pop_front();
+        }
+        if (!small_.empty()) {
+            small_.pop_front();
+        }
+        current_.pop_front();
+        overtake();
+        if (current_.size() <= small_.max_size()) {
+            level_down();
+        }
+        destroy_block(block);
+    }
+
+    void release_back_block() {
+        DataBlock *block = current_.back();
+        if (big_up_to_date()) {
+            big_.pop_back();
+        }
+        if (small_up_to_date() && current_.size() <= small_.max_size()) {
+            small_.pop_back();
+        }
+        current_.pop_back();
+        if (current_.size() <= small_.max_size()) {
+            level_down();
+        }
+        destroy_block(block);
+    }
+
     void reset() {
         for (size_type i = 0; i < current_.size(); ++i) {
-            for (pointer it = current_[i]->begin; it != current_[i]->end; ++it) {
-                allocator_.destroy(it);
-            }
-            allocator_.deallocate(current_[i]->buffer, DataBlock::SIZE);
-            delete current_[i];
+            destroy_block(current_[i]);
         }
     }
 
-    template <class Alloc2>
-    void copy(const Deque<T, Alloc2> &other) {
-        for (size_type i = 0; i != other.current_.size(); ++i) {
-            DataBlock *block = new DataBlock(*other.current_[i]);
-            auto beginOffset = block->begin - block->buffer;
-            auto endOffset = block->end - block->buffer;
+    void reset_maps(size_type smallSize, size_type currentSize, size_type bigSize) {
+        BlockMap(smallSize, MapAllocator(allocator_)).swap(small_);
+        BlockMap(currentSize, MapAllocator(allocator_)).swap(current_);
+        BlockMap(bigSize, MapAllocator(allocator_)).swap(big_);
+    }
 
-            pointer ptr = allocator_.allocate(DataBlock::SIZE);
-            std::copy(block->begin, block->end, ptr + beginOffset);
-            block->begin = ptr + beginOffset;
-            block->end = ptr + endOffset;
-            block->buffer = ptr;
+    void swap_maps(Deque &other) {
+        current_.swap(other.current_);
+        small_.swap(other.small_);
+        big_.swap(other.big_);
+    }
+
+    void assign_allocator(const Allocator &other, std::true_type) {
+        allocator_ = other;
+    }
+
+    void assign_allocator(const Allocator &, std::false_type) {}
+
+    void move_allocator(Allocator &other, std::true_type) {
+        allocator_ = std::move(other);
+    }
+
+    void move_allocator(Allocator &, std::false_type) {}
+
+    void swap_allocator(Allocator &other, std::true_type) {
+        std::swap(allocator_, other);
+    }
+
+    void swap_allocator(Allocator &, std::false_type) {}
+
+    void copy(const Deque &other) {
+        for (size_type i = 0; i != other.current_.size(); ++i) {
+            const DataBlock *source = other.current_[i];
+            DataBlock *block = create_block(false);
+            block->begin = block->end = block->buffer + (source->begin - source->buffer);
+            try {
+                for (pointer src = source->begin; src != source->end; ++src) {
+                    AllocTraits::construct(allocator_, block->end, *src);
+                    ++block->end;
+                }
+            } catch (...) {
+                destroy_block(block);
+                throw;
+            }
 
             small_.push_back(block);
             current_.push_back(block);
@@ -254,61 +520,212 @@ private:
         return std::make_pair(index / DataBlock::SIZE, index % DataBlock::SIZE);
     }
 
+    // Calls visit(pointer to element) for each index, in order. Each batch is
+    // resolved in passes so that the loads of one pass overlap: block
+    // headers are prefetched first, then the elements themselves.
+    template <class IndexIt, class Visit>
+    void visit_batched(IndexIt first, IndexIt last, Visit visit) const {
+        const size_type BATCH = 32;
+        const DataBlock *blocks[BATCH];
+        size_type offsets[BATCH];
+        pointer items[BATCH];
+        size_type start = current_.empty() ? 0 : current_.front()->begin - current_.front()->buffer;
+        while (first != last) {
+            size_type count = 0;
+            for (; count < BATCH && first != last; ++count, ++first) {
+                size_type index = start + *first;
+                blocks[count] = current_[index / DataBlock::SIZE];
+                offsets[count] = index % DataBlock::SIZE;
+                __builtin_prefetch(blocks[count]);
+            }
+            for (size_type i = 0; i < count; ++i) {
+                items[i] = blocks[i]->buffer + offsets[i];
+                __builtin_prefetch(items[i]);
+            }
+            for (size_type i = 0; i < count; ++i) {
+                visit(items[i]);
+            }
+        }
+    }
+
+    // Maps a key to an unsigned word whose unsigned order is the key order.
+    template <class Key, bool = std::is_floating_point<Key>::value>
+    struct RadixKey {
+        typedef typename std::make_unsigned<Key>::type type;
+        static type bits(Key key) {
+            const type sign = std::is_signed<Key>::value ? type(1) << (8 * sizeof(Key) - 1) : 0;
+            return static_cast<type>(key) ^ sign;
+        }
+    };
+
+    template <class Key>
+    struct RadixKey<Key, true> {
+        static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "Unsupported floating point key");
+        typedef typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type type;
+        static type bits(Key key) {
+            const type sign = type(1) << (8 * sizeof(Key) - 1);
+            type word;
+            std::memcpy(&word, &key, sizeof(Key));
+            return (word & sign) ? ~word : word | sign;
+        }
+    };
+
+    // Where the next element of a radix bucket goes in the destination layout.
+    struct RadixCursor {
+        pointer ptr, blockEnd;
+        size_type block;
+    };
+
+    void free_buffers(std::vector<pointer> &buffers) {
+        for (pointer buffer : buffers) {
+            AllocTraits::deallocate(allocator_, buffer, DataBlock::SIZE);
+        }
+        buffers.clear();
+    }
+
+    // Stable scatter of every element from the src buffers into the dst
+    // buffers by one byte of its key. Both sets of buffers share the layout
+    // of current_, so the bucket cursors only step from block to block.
+    template <class KeyFn, class Key>
+    void radix_scatter(KeyFn &key, int shift, const size_type *count,
+                       const std::vector<pointer> &src, const std::vector<pointer> &dst) {
+        RadixCursor cursors[256];
+        size_type start = current_.front()->begin - current_.front()->buffer;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            if (count[bucket] == 0) {
+                continue;
+            }
+            RadixCursor &cursor = cursors[bucket];
+            cursor.block = start / DataBlock::SIZE;
+            cursor.ptr = dst[cursor.block] + start % DataBlock::SIZE;
+            cursor.blockEnd = dst[cursor.block] + DataBlock::SIZE;
+            start += count[bucket];
+        }
+        for (size_type i = 0; i < current_.size(); ++i) {
+            const DataBlock *block = current_[i];
+            pointer first = src[i] + (block->begin - block->buffer);
+            pointer last = src[i] + (block->end - block->buffer);
+            for (pointer it = first; it != last; ++it) {
+                typename RadixKey<Key>::type word = RadixKey<Key>::bits(key(*it));
+                RadixCursor &cursor = cursors[(word >> shift) & 255];
+                if (cursor.ptr == cursor.blockEnd) {
+                    ++cursor.block;
+                    cursor.ptr = dst[cursor.block];
+                    cursor.blockEnd = cursor.ptr + DataBlock::SIZE;
+                }
+                AllocTraits::construct(allocator_, cursor.ptr, std::move(*it));
+                AllocTraits::destroy(allocator_, it);
+                ++cursor.ptr;
+            }
+        }
+    }
+
 public:
     typedef DequeIterator<value_type, reference, pointer, Deque<T, Allocator>> iterator;
     typedef DequeIterator<const value_type, const_reference, const_pointer, const Deque<T, Allocator>> const_iterator;
     typedef std::reverse_iterator<iterator> reverse_iterator;
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
     typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+    typedef Segment<pointer> segment;
+    typedef Segment<const_pointer> const_segment;
+    typedef SegmentRange<segment, Deque<T, Allocator>> segment_range;
+    typedef SegmentRange<const_segment, const Deque<T, Allocator>> const_segment_range;
 
     const static std::size_t MIN_BUFFER_SIZE = 4;
 
     Deque(const Allocator &allocator = Allocator()) :
-            small_(MIN_BUFFER_SIZE),
-            current_(MIN_BUFFER_SIZE * 2),
-            big_(MIN_BUFFER_SIZE * 4),
-            allocator_(allocator)
+            allocator_(allocator),
+            current_(0, MapAllocator(allocator_)),
+            small_(0, MapAllocator(allocator_)),
+            big_(0, MapAllocator(allocator_))
     {}
 
-//    template <class Alloc2>
     Deque(const Deque &other) :
-            small_(other.small_.max_size()),
-            current_(other.current_.max_size()),
-            big_(other.big_.max_size()),
-            allocator_() {
-        copy(other);
+            allocator_(AllocTraits::select_on_container_copy_construction(other.allocator_)),
+            current_(other.current_.max_size(), MapAllocator(allocator_)),
+            small_(other.small_.max_size(), MapAllocator(allocator_)),
+            big_(other.big_.max_size(), MapAllocator(allocator_)) {
+        try {
+            copy(other);
+        } catch (...) {
+            reset();
+            throw;
+        }
+    }
+
+    Deque(Deque &&other) :
+            allocator_(std::move(other.allocator_)),
+            current_(0, MapAllocator(allocator_)),
+            small_(0, MapAllocator(allocator_)),
+            big_(0, MapAllocator(allocator_)) {
+        swap_maps(other);
     }
 
-    template <class Alloc2>
-    Deque &operator =(const Deque<T, Alloc2> &other) {
+    Deque &operator =(const Deque &other) {
         if (&other != this) {
             reset();
-            small_.reset_and_resize(other.small_.max_size());
-            current_.reset_and_resize(other.current_.max_size());
-            big_.reset_and_resize(other.big_.max_size());
+            reset_maps(0, 0, 0);
+            assign_allocator(other.allocator_,
+                             typename AllocTraits::propagate_on_container_copy_assignment());
+            reset_maps(other.small_.max_size(), other.current_.max_size(), other.big_.max_size());
             copy(other);
         }
         return *this;
     }
 
+    Deque &operator =(Deque &&other) {
+        if (&other == this) {
+            return *this;
+        }
+        reset();
+        reset_maps(0, 0, 0);
+        if (AllocTraits::propagate_on_container_move_assignment::value || allocator_ == other.allocator_) {
+            move_allocator(other.allocator_,
+                           typename AllocTraits::propagate_on_container_move_assignment());
+            swap_maps(other);
+        } else {
+            reset_maps(other.small_.max_size(), other.current_.max_size(), other.big_.max_size());
+            copy(other);
+        }
+        return *this;
+    }
+
+    void swap(Deque &other) {
+        swap_allocator(other.allocator_, typename AllocTraits::propagate_on_container_swap());
+        swap_maps(other);
+    }
+
+    friend void swap(Deque &a, Deque &b) {
+        a.swap(b);
+    }
+
     ~Deque() {
         reset();
     }
 
     void push_back(const value_type &val) {
-        if (current_.empty() || !current_.back()->can_push_back()) {
-            if (current_.full()) {
-                level_up();
-            }
-            pointer ptr = allocator_.allocate(DataBlock::SIZE);
-            DataBlock *block = new DataBlock(ptr);
-            current_.push_back(block);
-            if (!small_.full()) {
-                small_.push_back(block);
-            }
+        prepare_back_block();
+        AllocTraits::construct(allocator_, current_.back()->end, val);
+        ++current_.back()->end;
+    }
+
+    void push_back(value_type &&val) {
+        prepare_back_block();
+        AllocTraits::construct(allocator_, current_.back()->end, std::move(val));
+        ++current_.back()->end;
+    }
+
+    // Appends n default-initialized elements: trivially default
+    // constructible T is left uninitialized, to be filled in place (e.g.
+    // through segments()). Blocks are added as for push_back.
+    void grow_back(size_type n) {
+        while (n != 0) {
+            prepare_back_block();
+            DataBlock *block = current_.back();
+            size_type count = std::min(n, static_cast<size_type>(block->buffer + DataBlock::SIZE - block->end));
+            construct_back(block, count, std::is_trivially_default_constructible<T>());
+            n -= count;
         }
-        overtake();
-        allocator_.construct(current_.back()->end++, val);
     }
 
     void pop_back() {
@@ -316,62 +733,60 @@ public:
             throw std::runtime_error("Deque is already empty");
         }
         overtake();
-        allocator_.destroy(--current_.back()->end);
+        AllocTraits::destroy(allocator_, --current_.back()->end);
         if (current_.back()->empty()) {
-            DataBlock *block = current_.back();
-            if (big_up_to_date()) {
-                big_.pop_back();
-            }
-            if (small_up_to_date() && current_.size() <= small_.max_size()) {
-                small_.pop_back();
-            }
-            current_.pop_back();
-            if (current_.size() <= small_.max_size()) {
-                level_down();
-            }
-            allocator_.deallocate(block->buffer, DataBlock::SIZE);
-            delete block;
+            release_back_block();
         }
     }
 
     void push_front(const value_type &val) {
-        if (current_.empty() || !current_.front()->can_push_front()) {
-            if (current_.full()) {
-                level_up();
-            }
-            pointer ptr = allocator_.allocate(DataBlock::SIZE);
-            DataBlock *block = new DataBlock(ptr, true);
-            current_.push_front(block);
-            big_.push_front(block);
-            if (small_.full()) {
-                small_.pop_back();
-            }
-            small_.push_front(block);
-        }
-        overtake();
-        allocator_.construct(--current_.front()->begin, val);
+        prepare_front_block();
+        AllocTraits::construct(allocator_, current_.front()->begin - 1, val);
+        --current_.front()->begin;
+    }
+
+    void push_front(value_type &&val) {
+        prepare_front_block();
+        AllocTraits::construct(allocator_, current_.front()->begin - 1, std::move(val));
+        --current_.front()->begin;
     }
 
     void pop_front() {
         if (empty()) {
             throw std::runtime_error("Deque is already empty");
         }
-        allocator_.destroy(current_.front()->begin++);
+        AllocTraits::destroy(allocator_, current_.front()->begin++);
         if (current_.front()->empty()) {
-            DataBlock *block = current_.front();
-            if (!big_.empty()) {
-                big_.pop_front();
-            }
-            if (!small_.empty()) {
-                small_.pop_front();
-            }
-            current_.pop_front();
+            release_front_block();
+        }
+    }
+
+    // Remove the last (first) n elements. Whole blocks are released at once,
+    // so for trivially destructible T the cost is per block, not per element.
+    void pop_back_n(size_type n) {
+        if (n > size()) {
+            throw std::runtime_error("Deque has less than n elements");
+        }
+        while (n != 0 && n >= current_.back()->size()) {
+            n -= current_.back()->size();
             overtake();
-            if (current_.size() <= small_.max_size()) {
-                level_down();
-            }
-            allocator_.deallocate(block->buffer, DataBlock::SIZE);
-            delete block;
+            release_back_block();
+        }
+        for (; n != 0; --n) {
+            AllocTraits::destroy(allocator_, --current_.back()->end);
+        }
+    }
+
+    void pop_front_n(size_type n) {
+        if (n > size()) {
+            throw std::runtime_error("Deque has less than n elements");
+        }
+        while (n != 0 && n >= current_.front()->size()) {
+            n -= current_.front()->size();
+            release_front_block();
+        }
+        for (; n != 0; --n) {
+            AllocTraits::destroy(allocator_, current_.front()->begin++);
         }
     }
 
@@ -468,11 +883,147 @@ public:
         return const_reverse_iterator(begin());
     }
 
+    segment_range segments() {
+        return segment_range(0, size(), this);
+    }
+
+    const_segment_range segments() const {
+        return const_segment_range(0, size(), this);
+    }
+
+    segment_range segments(iterator first, iterator last) {
+        if (first.deque_ != this || last.deque_ != this) {
+            throw std::runtime_error("Container mismatch");
+        }
+        return segment_range(first.n_, last.n_, this);
+    }
+
+    const_segment_range segments(const_iterator first, const_iterator last) const {
+        if (first.deque_ != this || last.deque_ != this) {
+            throw std::runtime_error("Container mismatch");
+        }
+        return const_segment_range(first.n_, last.n_, this);
+    }
+
+    // LSD radix sort by an integral or floating point key, one byte per
+    // pass; stable. Each pass scatters into a second set of buffers with the
+    // same layout, and the DataBlocks are pointed at whichever set holds the
+    // result, so no element is reached through at(). Passes where every key
+    // has the same byte are skipped.
+    template <class KeyFn>
+    void radix_sort(KeyFn key) {
+        typedef typename std::decay<decltype(key(std::declval<const value_type &>()))>::type Key;
+        static_assert(std::is_arithmetic<Key>::value && !std::is_same<Key, bool>::value,
+                      "radix_sort needs an integral or floating point key");
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "radix_sort needs a nothrow move constructor");
+        typedef typename RadixKey<Key>::type Word;
+        const int passes = sizeof(Word);
+        size_type n = size();
+        if (n < 2) {
+            return;
+        }
+
+        std::vector<size_type> counts(passes * 256);
+        for (size_type i = 0; i < current_.size(); ++i) {
+            for (pointer it = current_[i]->begin; it != current_[i]->end; ++it) {
+                Word word = RadixKey<Key>::bits(key(*it));
+                for (int pass = 0; pass < passes; ++pass) {
+                    ++counts[pass * 256 + ((word >> (8 * pass)) & 255)];
+                }
+            }
+        }
+
+        std::vector<pointer> original, scratch;
+        original.reserve(current_.size());
+        scratch.reserve(current_.size());
+        try {
+            for (size_type i = 0; i < current_.size(); ++i) {
+                original.push_back(current_[i]->buffer);
+                scratch.push_back(AllocTraits::allocate(allocator_, DataBlock::SIZE));
+            }
+        } catch (...) {
+            free_buffers(scratch);
+            throw;
+        }
+
+        bool inScratch = false;
+        for (int pass = 0; pass < passes; ++pass) {
+            const size_type *count = &counts[pass * 256];
+            if (*std::max_element(count, count + 256) == n) {
+                continue;
+            }
+            radix_scatter<KeyFn, Key>(key, 8 * pass, count,
+                                      inScratch ? scratch : original, inScratch ? original : scratch);
+            inScratch = !inScratch;
+        }
+
+        if (inScratch) {
+            for (size_type i = 0; i < current_.size(); ++i) {
+                DataBlock *block = current_[i];
+                block->begin = scratch[i] + (block->begin - block->buffer);
+                block->end = scratch[i] + (block->end - block->buffer);
+                block->buffer = scratch[i];
+                scratch[i] = original[i];
+            }
+        }
+        free_buffers(scratch);
+    }
+
+    void radix_sort() {
+        radix_sort([](const value_type &val) { return val; });
+    }
+
+    // out[i] = (*this)[first[i]] for every index in [first, last). Lookups
+    // are done in batches with their block headers and targets prefetched.
+    template <class IndexIt, class OutputIt>
+    OutputIt gather(IndexIt first, IndexIt last, OutputIt out) const {
+        visit_batched(first, last, [&out](pointer item) {
+            *out = *item;
+            ++out;
+        });
+        return out;
+    }
+
+    // (*this)[first[i]] = values[i] for every index in [first, last).
+    template <class IndexIt, class InputIt>
+    void scatter(IndexIt first, IndexIt last, InputIt values) {
+        visit_batched(first, last, [&values](pointer item) {
+            *item = *values;
+            ++values;
+        });
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_;
+    }
+
+    // Elements of the i-th block and the index of its first element.
+    const_segment block_segment(size_type i) const {
+        return const_segment(current_[i]->begin, current_[i]->size());
+    }
+
+    size_type block_first_index(size_type i) const {
+        return i == 0 ? 0 : current_.front()->size() + (i - 1) * DataBlock::SIZE;
+    }
+
+    // Elements push_back can add before it allocates a new block.
+    size_type back_capacity() const {
+        if (current_.empty()) {
+            return 0;
+        }
+        return current_.back()->buffer + DataBlock::SIZE - current_.back()->end;
+    }
+
+    static size_type block_size() {
+        return DataBlock::SIZE;
+    }
+
     size_t getBlocksCount() const {
         return current_.size();
     }
 
-    const RingBuffer<DataBlock *> &getBlocks() const {
+    const BlockMap &getBlocks() const {
         return current_;
     }
 };
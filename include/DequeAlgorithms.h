@@ -0,0 +1,534 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_DEQUEALGORITHMS_H
+#define DEQUE_DEQUEALGORITHMS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "Deque.h"
+
+// Search and reduction over the contiguous DataBlock buffers of a Deque. The
+// per-buffer kernels below are scalar for every type; int32_t and float get
+// AVX2 or SSE2 versions, picked at compile time from the target flags. Other
+// types, int64_t and double included, only get the scalar loops.
+//
+// Sums have the element type. Integer sums wrap around modulo 2^bits, on the
+// scalar and the vector paths alike, instead of overflowing. Vectorized sums
+// of float are accumulated in several lanes, so rounding may differ from a
+// left-to-right std::accumulate. min/max assume there are no NaNs.
+
+// Type integer sums are accumulated in: unsigned, so that overflow wraps.
+template <class T, bool Wraps = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct SumAccumulator {
+    typedef T type;
+};
+
+template <class T>
+struct SumAccumulator<T, true> {
+    typedef typename std::make_unsigned<T>::type type;
+};
+
+template <class T>
+struct ScalarKernels {
+    static std::size_t find(const T *data, std::size_t n, const T &value) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    static std::size_t count(const T *data, std::size_t n, const T &value) {
+        std::size_t ans = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            ans += data[i] == value;
+        }
+        return ans;
+    }
+
+    static T sum(const T *data, std::size_t n) {
+        typedef typename SumAccumulator<T>::type Acc;
+        Acc ans = Acc();
+        for (std::size_t i = 0; i < n; ++i) {
+            ans = static_cast<Acc>(ans + static_cast<Acc>(data[i]));
+        }
+        return static_cast<T>(ans);
+    }
+
+    // Index of the first minimum (maximum) of a non-empty buffer.
+    static std::size_t min_index(const T *data, std::size_t n) {
+        std::size_t ans = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            if (data[i] < data[ans]) {
+                ans = i;
+            }
+        }
+        return ans;
+    }
+
+    static std::size_t max_index(const T *data, std::size_t n) {
+        std::size_t ans = 0;
+        for (std::size_t i = 1; i < n; ++i) {
+            if (data[ans] < data[i]) {
+                ans = i;
+            }
+        }
+        return ans;
+    }
+};
+
+template <class T>
+struct SimdKernels : ScalarKernels<T> {
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct SimdKernels<std::int32_t> : ScalarKernels<std::int32_t> {
+    typedef ScalarKernels<std::int32_t> Scalar;
+
+    static __m256i load(const std::int32_t *data) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    }
+
+    static std::int32_t lane_min(__m256i v) {
+        __m128i x = _mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+        x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(x);
+    }
+
+    static std::int32_t lane_max(__m256i v) {
+        __m128i x = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+        x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(x);
+    }
+
+    static std::size_t find(const std::int32_t *data, std::size_t n, const std::int32_t &value) {
+        __m256i needle = _mm256_set1_epi32(value);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(load(data + i), needle)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + Scalar::find(data + i, n - i, value);
+    }
+
+    static std::size_t count(const std::int32_t *data, std::size_t n, const std::int32_t &value) {
+        __m256i needle = _mm256_set1_epi32(value);
+        std::size_t ans = 0, i = 0;
+        for (; i + 8 <= n; i += 8) {
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(load(data + i), needle)));
+            ans += __builtin_popcount(mask);
+        }
+        return ans + Scalar::count(data + i, n - i, value);
+    }
+
+    static std::int32_t sum(const std::int32_t *data, std::size_t n) {
+        __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            acc0 = _mm256_add_epi32(acc0, load(data + i));
+            acc1 = _mm256_add_epi32(acc1, load(data + i + 8));
+        }
+        __m256i acc = _mm256_add_epi32(acc0, acc1);
+        __m128i x = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+        x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+        // Wrap around like the vector lanes do instead of overflowing a signed int.
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(_mm_cvtsi128_si32(x)) +
+                                         static_cast<std::uint32_t>(Scalar::sum(data + i, n - i)));
+    }
+
+    static std::size_t min_index(const std::int32_t *data, std::size_t n) {
+        if (n < 8) {
+            return Scalar::min_index(data, n);
+        }
+        __m256i acc = load(data);
+        for (std::size_t i = 8; i + 8 <= n; i += 8) {
+            acc = _mm256_min_epi32(acc, load(data + i));
+        }
+        std::int32_t best = lane_min(acc);
+        for (std::size_t i = n / 8 * 8; i < n; ++i) {
+            best = data[i] < best ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+
+    static std::size_t max_index(const std::int32_t *data, std::size_t n) {
+        if (n < 8) {
+            return Scalar::max_index(data, n);
+        }
+        __m256i acc = load(data);
+        for (std::size_t i = 8; i + 8 <= n; i += 8) {
+            acc = _mm256_max_epi32(acc, load(data + i));
+        }
+        std::int32_t best = lane_max(acc);
+        for (std::size_t i = n / 8 * 8; i < n; ++i) {
+            best = best < data[i] ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+};
+
+template <>
+struct SimdKernels<float> : ScalarKernels<float> {
+    typedef ScalarKernels<float> Scalar;
+
+    static float lane_reduce_min(__m256 v) {
+        __m128 x = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_min_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(x);
+    }
+
+    static float lane_reduce_max(__m256 v) {
+        __m128 x = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_max_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(x);
+    }
+
+    static std::size_t find(const float *data, std::size_t n, const float &value) {
+        __m256 needle = _mm256_set1_ps(value);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + Scalar::find(data + i, n - i, value);
+    }
+
+    static std::size_t count(const float *data, std::size_t n, const float &value) {
+        __m256 needle = _mm256_set1_ps(value);
+        std::size_t ans = 0, i = 0;
+        for (; i + 8 <= n; i += 8) {
+            ans += __builtin_popcount(_mm256_movemask_ps(
+                    _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ)));
+        }
+        return ans + Scalar::count(data + i, n - i, value);
+    }
+
+    static float sum(const float *data, std::size_t n) {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(data + i));
+            acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(data + i + 8));
+        }
+        __m256 acc = _mm256_add_ps(acc0, acc1);
+        __m128 x = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 1, 1, 1)));
+        return _mm_cvtss_f32(x) + Scalar::sum(data + i, n - i);
+    }
+
+    static std::size_t min_index(const float *data, std::size_t n) {
+        if (n < 8) {
+            return Scalar::min_index(data, n);
+        }
+        __m256 acc = _mm256_loadu_ps(data);
+        for (std::size_t i = 8; i + 8 <= n; i += 8) {
+            acc = _mm256_min_ps(acc, _mm256_loadu_ps(data + i));
+        }
+        float best = lane_reduce_min(acc);
+        for (std::size_t i = n / 8 * 8; i < n; ++i) {
+            best = data[i] < best ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+
+    static std::size_t max_index(const float *data, std::size_t n) {
+        if (n < 8) {
+            return Scalar::max_index(data, n);
+        }
+        __m256 acc = _mm256_loadu_ps(data);
+        for (std::size_t i = 8; i + 8 <= n; i += 8) {
+            acc = _mm256_max_ps(acc, _mm256_loadu_ps(data + i));
+        }
+        float best = lane_reduce_max(acc);
+        for (std::size_t i = n / 8 * 8; i < n; ++i) {
+            best = best < data[i] ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+};
+
+#elif defined(__SSE2__)
+
+template <>
+struct SimdKernels<std::int32_t> : ScalarKernels<std::int32_t> {
+    typedef ScalarKernels<std::int32_t> Scalar;
+
+    static __m128i load(const std::int32_t *data) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    }
+
+    // SSE2 has no packed 32-bit min/max; select through a compare mask.
+    static __m128i select(__m128i mask, __m128i a, __m128i b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static std::int32_t lane(__m128i v, int i) {
+        std::int32_t lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), v);
+        return lanes[i];
+    }
+
+    static std::size_t find(const std::int32_t *data, std::size_t n, const std::int32_t &value) {
+        __m128i needle = _mm_set1_epi32(value);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(load(data + i), needle)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + Scalar::find(data + i, n - i, value);
+    }
+
+    static std::size_t count(const std::int32_t *data, std::size_t n, const std::int32_t &value) {
+        __m128i needle = _mm_set1_epi32(value);
+        std::size_t ans = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            ans += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(load(data + i), needle))));
+        }
+        return ans + Scalar::count(data + i, n - i, value);
+    }
+
+    static std::int32_t sum(const std::int32_t *data, std::size_t n) {
+        __m128i acc = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = _mm_add_epi32(acc, load(data + i));
+        }
+        std::uint32_t ans = static_cast<std::uint32_t>(Scalar::sum(data + i, n - i));
+        for (int j = 0; j < 4; ++j) {
+            ans += static_cast<std::uint32_t>(lane(acc, j));
+        }
+        return static_cast<std::int32_t>(ans);
+    }
+
+    static std::size_t min_index(const std::int32_t *data, std::size_t n) {
+        if (n < 4) {
+            return Scalar::min_index(data, n);
+        }
+        __m128i acc = load(data);
+        for (std::size_t i = 4; i + 4 <= n; i += 4) {
+            __m128i v = load(data + i);
+            acc = select(_mm_cmplt_epi32(v, acc), v, acc);
+        }
+        std::int32_t best = lane(acc, 0);
+        for (int j = 1; j < 4; ++j) {
+            best = lane(acc, j) < best ? lane(acc, j) : best;
+        }
+        for (std::size_t i = n / 4 * 4; i < n; ++i) {
+            best = data[i] < best ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+
+    static std::size_t max_index(const std::int32_t *data, std::size_t n) {
+        if (n < 4) {
+            return Scalar::max_index(data, n);
+        }
+        __m128i acc = load(data);
+        for (std::size_t i = 4; i + 4 <= n; i += 4) {
+            __m128i v = load(data + i);
+            acc = select(_mm_cmpgt_epi32(v, acc), v, acc);
+        }
+        std::int32_t best = lane(acc, 0);
+        for (int j = 1; j < 4; ++j) {
+            best = best < lane(acc, j) ? lane(acc, j) : best;
+        }
+        for (std::size_t i = n / 4 * 4; i < n; ++i) {
+            best = best < data[i] ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+};
+
+template <>
+struct SimdKernels<float> : ScalarKernels<float> {
+    typedef ScalarKernels<float> Scalar;
+
+    static float lane(__m128 v, int i) {
+        float lanes[4];
+        _mm_storeu_ps(lanes, v);
+        return lanes[i];
+    }
+
+    static std::size_t find(const float *data, std::size_t n, const float &value) {
+        __m128 needle = _mm_set1_ps(value);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + Scalar::find(data + i, n - i, value);
+    }
+
+    static std::size_t count(const float *data, std::size_t n, const float &value) {
+        __m128 needle = _mm_set1_ps(value);
+        std::size_t ans = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            ans += __builtin_popcount(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle)));
+        }
+        return ans + Scalar::count(data + i, n - i, value);
+    }
+
+    static float sum(const float *data, std::size_t n) {
+        __m128 acc = _mm_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc = _mm_add_ps(acc, _mm_loadu_ps(data + i));
+        }
+        return (lane(acc, 0) + lane(acc, 1)) + (lane(acc, 2) + lane(acc, 3)) + Scalar::sum(data + i, n - i);
+    }
+
+    static std::size_t min_index(const float *data, std::size_t n) {
+        if (n < 4) {
+            return Scalar::min_index(data, n);
+        }
+        __m128 acc = _mm_loadu_ps(data);
+        for (std::size_t i = 4; i + 4 <= n; i += 4) {
+            acc = _mm_min_ps(acc, _mm_loadu_ps(data + i));
+        }
+        float best = lane(acc, 0);
+        for (int j = 1; j < 4; ++j) {
+            best = lane(acc, j) < best ? lane(acc, j) : best;
+        }
+        for (std::size_t i = n / 4 * 4; i < n; ++i) {
+            best = data[i] < best ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+
+    static std::size_t max_index(const float *data, std::size_t n) {
+        if (n < 4) {
+            return Scalar::max_index(data, n);
+        }
+        __m128 acc = _mm_loadu_ps(data);
+        for (std::size_t i = 4; i + 4 <= n; i += 4) {
+            acc = _mm_max_ps(acc, _mm_loadu_ps(data + i));
+        }
+        float best = lane(acc, 0);
+        for (int j = 1; j < 4; ++j) {
+            best = best < lane(acc, j) ? lane(acc, j) : best;
+        }
+        for (std::size_t i = n / 4 * 4; i < n; ++i) {
+            best = best < data[i] ? data[i] : best;
+        }
+        return find(data, n, best);
+    }
+};
+
+#endif
+
+template <class T, class Allocator>
+std::size_t deque_find_index(const Deque<T, Allocator> &deque, const T &value) {
+    typedef SimdKernels<typename std::remove_cv<T>::type> Kernels;
+    std::size_t offset = 0;
+    for (auto segment : deque.segments()) {
+        std::size_t i = Kernels::find(segment.data(), segment.size(), value);
+        if (i != segment.size()) {
+            return offset + i;
+        }
+        offset += segment.size();
+    }
+    return offset;
+}
+
+// Index of the first minimum (Less) or maximum, deque.size() if it is empty.
+template <class T, class Allocator, bool Less>
+std::size_t deque_extremum_index(const Deque<T, Allocator> &deque) {
+    typedef SimdKernels<typename std::remove_cv<T>::type> Kernels;
+    std::size_t offset = 0, ans = deque.size();
+    const T *best = nullptr;
+    for (auto segment : deque.segments()) {
+        std::size_t i = Less ? Kernels::min_index(segment.data(), segment.size()) :
+                               Kernels::max_index(segment.data(), segment.size());
+        const T *candidate = segment.data() + i;
+        if (best == nullptr || (Less ? *candidate < *best : *best < *candidate)) {
+            best = candidate;
+            ans = offset + i;
+        }
+        offset += segment.size();
+    }
+    return ans;
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::const_iterator deque_find(const Deque<T, Allocator> &deque, const T &value) {
+    return deque.begin() + deque_find_index(deque, value);
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::iterator deque_find(Deque<T, Allocator> &deque, const T &value) {
+    return deque.begin() + deque_find_index(static_cast<const Deque<T, Allocator> &>(deque), value);
+}
+
+template <class T, class Allocator>
+bool deque_contains(const Deque<T, Allocator> &deque, const T &value) {
+    return deque_find_index(deque, value) != deque.size();
+}
+
+template <class T, class Allocator>
+std::size_t deque_count(const Deque<T, Allocator> &deque, const T &value) {
+    typedef SimdKernels<typename std::remove_cv<T>::type> Kernels;
+    std::size_t ans = 0;
+    for (auto segment : deque.segments()) {
+        ans += Kernels::count(segment.data(), segment.size(), value);
+    }
+    return ans;
+}
+
+// Sum in the element type; integer sums wrap around.
+template <class T, class Allocator>
+T deque_sum(const Deque<T, Allocator> &deque) {
+    typedef SimdKernels<typename std::remove_cv<T>::type> Kernels;
+    typedef typename SumAccumulator<T>::type Acc;
+    Acc ans = Acc();
+    for (auto segment : deque.segments()) {
+        ans = static_cast<Acc>(ans + static_cast<Acc>(Kernels::sum(segment.data(), segment.size())));
+    }
+    return static_cast<T>(ans);
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::const_iterator deque_min_element(const Deque<T, Allocator> &deque) {
+    return deque.begin() + deque_extremum_index<T, Allocator, true>(deque);
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::iterator deque_min_element(Deque<T, Allocator> &deque) {
+    return deque.begin() + deque_extremum_index<T, Allocator, true>(deque);
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::const_iterator deque_max_element(const Deque<T, Allocator> &deque) {
+    return deque.begin() + deque_extremum_index<T, Allocator, false>(deque);
+}
+
+template <class T, class Allocator>
+typename Deque<T, Allocator>::iterator deque_max_element(Deque<T, Allocator> &deque) {
+    return deque.begin() + deque_extremum_index<T, Allocator, false>(deque);
+}
+
+#endif //DEQUE_DEQUEALGORITHMS_H
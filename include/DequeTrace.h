@@ -0,0 +1,390 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_DEQUETRACE_H
+#define DEQUE_DEQUETRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Deque.h"
+
+enum TraceOp : std::uint8_t {
+    TRACE_PUSH_BACK,
+    TRACE_PUSH_FRONT,
+    TRACE_POP_BACK,
+    TRACE_POP_FRONT,
+    TRACE_AT,
+    TRACE_ITERATE
+};
+
+struct TraceRecord {
+    TraceOp op;
+    std::int64_t arg;
+};
+
+// Compact binary log of deque operations. After an 8-byte magic every
+// record is one op byte, followed for pushes by the value as a zigzag varint
+// and for TRACE_AT by the index as a varint.
+//
+// A default-constructed Trace keeps everything in memory. A Trace opened on
+// a file streams instead: records are buffered and written out whenever the
+// buffer reaches flushBytes, so a long capture holds at most that much in
+// memory and survives a crash up to the last flush. A streaming trace cannot
+// be decoded or saved; load its file instead.
+class Trace {
+private:
+    std::vector<std::uint8_t> bytes_;
+    std::size_t size_;
+    std::ofstream out_;
+    std::string path_;
+    std::size_t flushBytes_;
+    std::size_t flushed_;
+
+    static const char *magic() {
+        return "DQTRACE1";
+    }
+
+    enum : std::size_t {
+        MAGIC_SIZE = 8
+    };
+
+    static bool has_arg(TraceOp op) {
+        return op == TRACE_PUSH_BACK || op == TRACE_PUSH_FRONT || op == TRACE_AT;
+    }
+
+    void put_varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes_.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint64_t get_varint(std::size_t &pos) const {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == bytes_.size()) {
+                break;
+            }
+            std::uint8_t byte = bytes_[pos++];
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Truncated trace record");
+    }
+
+    void write_buffer() {
+        out_.write(reinterpret_cast<const char *>(bytes_.data()), bytes_.size());
+        out_.flush();
+        flushed_ += bytes_.size();
+        bytes_.clear();
+    }
+
+    void check_in_memory() const {
+        if (streaming()) {
+            throw std::runtime_error("Trace is streamed to " + path_);
+        }
+    }
+
+public:
+    enum : std::size_t {
+        FLUSH_BYTES = 1 << 16
+    };
+
+    Trace() : bytes_(magic(), magic() + MAGIC_SIZE), size_(0), flushBytes_(0), flushed_(0) {}
+
+    explicit Trace(const std::string &path, std::size_t flushBytes = FLUSH_BYTES) :
+            bytes_(magic(), magic() + MAGIC_SIZE),
+            size_(0),
+            out_(path, std::ios::binary | std::ios::trunc),
+            path_(path),
+            flushBytes_(flushBytes),
+            flushed_(0) {
+        if (!out_) {
+            throw std::runtime_error("Cannot write trace " + path);
+        }
+        flush();
+    }
+
+    Trace(Trace &&) = default;
+    Trace &operator =(Trace &&) = default;
+
+    ~Trace() {
+        if (streaming()) {
+            write_buffer();
+        }
+    }
+
+    bool streaming() const {
+        return out_.is_open();
+    }
+
+    // Writes the buffered records of a streaming trace to its file.
+    void flush() {
+        if (streaming()) {
+            write_buffer();
+            if (!out_) {
+                throw std::runtime_error("Cannot write trace " + path_);
+            }
+        }
+    }
+
+    void append(TraceOp op, std::int64_t arg = 0) {
+        bytes_.push_back(op);
+        if (op == TRACE_AT) {
+            put_varint(static_cast<std::uint64_t>(arg));
+        } else if (has_arg(op)) {
+            put_varint((static_cast<std::uint64_t>(arg) << 1) ^ static_cast<std::uint64_t>(arg >> 63));
+        }
+        ++size_;
+        if (streaming() && bytes_.size() >= flushBytes_) {
+            flush();
+        }
+    }
+
+    std::vector<TraceRecord> decode() const {
+        check_in_memory();
+        std::vector<TraceRecord> records;
+        records.reserve(size_);
+        std::size_t pos = MAGIC_SIZE;
+        while (pos < bytes_.size()) {
+            std::uint8_t op = bytes_[pos++];
+            if (op > TRACE_ITERATE) {
+                throw std::runtime_error("Unknown trace op");
+            }
+            TraceRecord record{static_cast<TraceOp>(op), 0};
+            if (record.op == TRACE_AT) {
+                record.arg = static_cast<std::int64_t>(get_varint(pos));
+            } else if (has_arg(record.op)) {
+                std::uint64_t word = get_varint(pos);
+                record.arg = static_cast<std::int64_t>(word >> 1) ^ -static_cast<std::int64_t>(word & 1);
+            }
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    void save(const std::string &path) const {
+        check_in_memory();
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(bytes_.data()), bytes_.size());
+        if (!out) {
+            throw std::runtime_error("Cannot write trace " + path);
+        }
+    }
+
+    static Trace load(const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Cannot read trace " + path);
+        }
+        Trace trace;
+        trace.bytes_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (trace.bytes_.size() < MAGIC_SIZE || std::memcmp(trace.bytes_.data(), magic(), MAGIC_SIZE) != 0) {
+            throw std::runtime_error("Not a deque trace: " + path);
+        }
+        trace.size_ = trace.decode().size();
+        return trace;
+    }
+
+    // Number of records.
+    std::size_t size() const {
+        return size_;
+    }
+
+    // Total size, including what a streaming trace has already written.
+    std::size_t bytes_size() const {
+        return flushed_ + bytes_.size();
+    }
+
+    // Bytes held in memory.
+    std::size_t buffered_size() const {
+        return bytes_.size();
+    }
+};
+
+// What a RecordingDeque logs for pushed values. By default every value is
+// logged as 0, so a production trace keeps the shape of the workload but
+// none of its data (ids, offsets); raw capture has to be asked for.
+enum TraceValues {
+    TRACE_ANONYMIZED,
+    TRACE_RAW_VALUES
+};
+
+// Raw value logged for a push. Non-arithmetic elements are logged as 0.
+template <class T>
+std::int64_t trace_value(const T &value, typename std::enable_if<std::is_arithmetic<T>::value>::type * = nullptr) {
+    return static_cast<std::int64_t>(value);
+}
+
+template <class T>
+std::int64_t trace_value(const T &, typename std::enable_if<!std::is_arithmetic<T>::value>::type * = nullptr) {
+    return 0;
+}
+
+// Applies one record to any deque-like container of integers. Returns what
+// the operation read (the element, or the sum for TRACE_ITERATE), so that
+// replays against different containers can be checked against each other.
+// Pops of an empty container and indexes past the end throw.
+template <class Container>
+std::uint64_t apply_trace_record(Container &container, const TraceRecord &record) {
+    typedef typename Container::value_type value_type;
+    switch (record.op) {
+        case TRACE_PUSH_BACK:
+            container.push_back(static_cast<value_type>(record.arg));
+            return 0;
+        case TRACE_PUSH_FRONT:
+            container.push_front(static_cast<value_type>(record.arg));
+            return 0;
+        case TRACE_POP_BACK:
+            if (container.empty()) {
+                throw std::runtime_error("Trace pops an empty container");
+            }
+            container.pop_back();
+            return 0;
+        case TRACE_POP_FRONT:
+            if (container.empty()) {
+                throw std::runtime_error("Trace pops an empty container");
+            }
+            container.pop_front();
+            return 0;
+        case TRACE_AT:
+            if (static_cast<std::uint64_t>(record.arg) >= container.size()) {
+                throw std::runtime_error("Trace index out of range");
+            }
+            return static_cast<std::uint64_t>(container[static_cast<std::size_t>(record.arg)]);
+        case TRACE_ITERATE: {
+            std::uint64_t sum = 0;
+            for (const auto &value : container) {
+                sum += static_cast<std::uint64_t>(value);
+            }
+            return sum;
+        }
+    }
+    return 0;
+}
+
+template <class Container>
+std::uint64_t replay_trace(const std::vector<TraceRecord> &records, Container &container) {
+    std::uint64_t checksum = 0;
+    for (const TraceRecord &record : records) {
+        checksum = checksum * 31 + apply_trace_record(container, record);
+    }
+    return checksum;
+}
+
+// Deque that logs every operation into a Trace while one is attached.
+// Pushed values are logged according to TraceValues.
+template <class T, class Allocator = std::allocator<T>>
+class RecordingDeque {
+public:
+    typedef T value_type;
+    typedef typename Deque<T, Allocator>::size_type size_type;
+private:
+    Deque<T, Allocator> deque_;
+    Trace *trace_;
+    TraceValues values_;
+
+    void record(TraceOp op, std::int64_t arg = 0) {
+        if (trace_ != nullptr) {
+            trace_->append(op, arg);
+        }
+    }
+
+    std::int64_t logged(const T &value) const {
+        return values_ == TRACE_RAW_VALUES ? trace_value(value) : 0;
+    }
+
+public:
+    explicit RecordingDeque(Trace *trace = nullptr, TraceValues values = TRACE_ANONYMIZED,
+                            const Allocator &allocator = Allocator()) :
+            deque_(allocator),
+            trace_(nullptr),
+            values_(values) {
+        attach(trace, values);
+    }
+
+    // Starts (with nullptr, stops) recording. The current contents are
+    // logged first as pushes, so that the trace replays from empty.
+    void attach(Trace *trace, TraceValues values = TRACE_ANONYMIZED) {
+        trace_ = trace;
+        values_ = values;
+        if (trace_ != nullptr) {
+            for (const auto &value : deque_) {
+                record(TRACE_PUSH_BACK, logged(value));
+            }
+        }
+    }
+
+    void push_back(const T &value) {
+        deque_.push_back(value);
+        record(TRACE_PUSH_BACK, logged(value));
+    }
+
+    void push_front(const T &value) {
+        deque_.push_front(value);
+        record(TRACE_PUSH_FRONT, logged(value));
+    }
+
+    void pop_back() {
+        deque_.pop_back();
+        record(TRACE_POP_BACK);
+    }
+
+    void pop_front() {
+        deque_.pop_front();
+        record(TRACE_POP_FRONT);
+    }
+
+    T &operator [](size_type n) {
+        record(TRACE_AT, n);
+        return deque_[n];
+    }
+
+    T &front() {
+        return (*this)[0];
+    }
+
+    T &back() {
+        return (*this)[size() - 1];
+    }
+
+    // Calls f on every element, front to back.
+    template <class Function>
+    void for_each(Function f) {
+        record(TRACE_ITERATE);
+        for (auto &value : deque_) {
+            f(value);
+        }
+    }
+
+    bool empty() const {
+        return deque_.empty();
+    }
+
+    size_type size() const {
+        return deque_.size();
+    }
+
+    // Unrecorded access.
+    Deque<T, Allocator> &data() {
+        return deque_;
+    }
+
+    const Deque<T, Allocator> &data() const {
+        return deque_;
+    }
+};
+
+#endif //DEQUE_DEQUETRACE_H
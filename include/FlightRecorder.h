@@ -0,0 +1,102 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_FLIGHTRECORDER_H
+#define DEQUE_FLIGHTRECORDER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Keeps the latest capacity() records written by a single thread. record()
+// is wait-free; snapshot() may run concurrently from any number of threads
+// and returns only records that were not overwritten while being copied.
+//
+// Two sequence counters make that check possible: started_ is bumped before
+// a slot is overwritten and written_ after the record is complete. A reader
+// copies records [written_ - capacity(), written_) and then discards those
+// whose slots the writer has started to reuse in the meantime.
+template <class T>
+class FlightRecorder {
+    static_assert(std::is_trivially_copyable<T>::value, "FlightRecorder requires trivially copyable records");
+private:
+    std::unique_ptr<T[]> values_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::uint64_t> started_;
+    alignas(64) std::atomic<std::uint64_t> written_;
+
+    static std::size_t capacity_of(std::size_t n) {
+        std::size_t capacity = 1;
+        while (capacity < n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    void copy_out(std::uint64_t first, std::uint64_t last, T *out) const {
+        std::size_t begin = first & mask_;
+        std::size_t n = last - first;
+        std::size_t firstLen = std::min(n, mask_ + 1 - begin);
+        std::memcpy(static_cast<void *>(out), &values_[begin], firstLen * sizeof(T));
+        std::memcpy(static_cast<void *>(out + firstLen), &values_[0], (n - firstLen) * sizeof(T));
+    }
+
+public:
+    explicit FlightRecorder(std::size_t capacity) :
+            values_(new T[capacity_of(capacity)]),
+            mask_(capacity_of(capacity) - 1),
+            started_(0),
+            written_(0)
+    {}
+
+    FlightRecorder(const FlightRecorder &) = delete;
+    FlightRecorder &operator =(const FlightRecorder &) = delete;
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    std::uint64_t recorded() const {
+        return written_.load(std::memory_order_acquire);
+    }
+
+    std::size_t size() const {
+        return std::min<std::uint64_t>(recorded(), capacity());
+    }
+
+    void record(const T &value) {
+        std::uint64_t n = written_.load(std::memory_order_relaxed);
+        started_.store(n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void *>(&values_[n & mask_]), &value, sizeof(T));
+        written_.store(n + 1, std::memory_order_release);
+    }
+
+    // Copies the retained records, oldest first, into out (room for
+    // capacity() elements). Returns how many were copied; the sequence
+    // number of out[0] is stored in *firstSeq.
+    std::size_t snapshot(T *out, std::uint64_t *firstSeq = nullptr) const {
+        std::uint64_t last = written_.load(std::memory_order_acquire);
+        std::uint64_t first = last > capacity() ? last - capacity() : 0;
+        copy_out(first, last, out);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t started = started_.load(std::memory_order_relaxed);
+        std::uint64_t valid = started > capacity() ? started - capacity() : 0;
+        if (valid > first) {
+            std::size_t dropped = std::min(valid, last) - first;
+            std::memmove(static_cast<void *>(out), out + dropped, (last - first - dropped) * sizeof(T));
+            first += dropped;
+        }
+        if (firstSeq != nullptr) {
+            *firstSeq = first;
+        }
+        return last - first;
+    }
+};
+
+#endif //DEQUE_FLIGHTRECORDER_H
@@ -0,0 +1,492 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_GROWABLERINGBUFFER_H
+#define DEQUE_GROWABLERINGBUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Ring buffer with power-of-two capacity that doubles when full. head_ and
+// tail_ are free-running counters; a slot is found by masking the counter
+// with capacity - 1, so indexing never branches on the wrap point.
+template <class T, class Allocator = std::allocator<T>>
+class GrowableRingBuffer {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef typename std::allocator_traits<Allocator>::pointer pointer;
+    typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
+    typedef std::size_t size_type;
+private:
+    typedef std::allocator_traits<Allocator> AllocTraits;
+
+    template <class IterType, class RefType, class PtrType, class RingBufferType>
+    class GrowableRingBufferIterator : public std::iterator<std::random_access_iterator_tag, IterType> {
+    public:
+        typedef std::ptrdiff_t difference_type;
+    private:
+        size_type pos_;
+        RingBufferType *ringBuf_;
+        GrowableRingBufferIterator(size_type pos, RingBufferType *ringBuf) :
+                pos_(pos), ringBuf_(ringBuf)
+        {}
+    public:
+        GrowableRingBufferIterator() : pos_(0), ringBuf_(nullptr) {}
+
+        bool operator ==(const GrowableRingBufferIterator &other) const {
+            return ringBuf_ == other.ringBuf_ && pos_ == other.pos_;
+        }
+
+        bool operator !=(const GrowableRingBufferIterator &other) const {
+            return !operator==(other);
+        }
+
+        RefType operator *() const {
+            return ringBuf_->arr_[pos_ & ringBuf_->mask_];
+        }
+
+        PtrType operator ->() const {
+            return &ringBuf_->arr_[pos_ & ringBuf_->mask_];
+        }
+
+        GrowableRingBufferIterator &operator ++() {
+            ++pos_;
+            return *this;
+        }
+
+        const GrowableRingBufferIterator operator ++(int) {
+            GrowableRingBufferIterator ans = *this;
+            ++pos_;
+            return ans;
+        }
+
+        GrowableRingBufferIterator &operator --() {
+            --pos_;
+            return *this;
+        }
+
+        const GrowableRingBufferIterator operator --(int) {
+            GrowableRingBufferIterator ans = *this;
+            --pos_;
+            return ans;
+        }
+
+        GrowableRingBufferIterator &operator +=(difference_type diff) {
+            pos_ += diff;
+            return *this;
+        }
+
+        GrowableRingBufferIterator &operator -=(difference_type diff) {
+            pos_ -= diff;
+            return *this;
+        }
+
+        const GrowableRingBufferIterator operator +(difference_type diff) const {
+            GrowableRingBufferIterator ans = *this;
+            ans += diff;
+            return ans;
+        }
+
+        const GrowableRingBufferIterator operator -(difference_type diff) const {
+            GrowableRingBufferIterator ans = *this;
+            ans -= diff;
+            return ans;
+        }
+
+        difference_type operator -(const GrowableRingBufferIterator &other) const {
+            if (ringBuf_ != other.ringBuf_) {
+                throw std::runtime_error("Container mismatch");
+            }
+            return static_cast<difference_type>(pos_ - other.pos_);
+        }
+
+        bool operator <(const GrowableRingBufferIterator &other) const {
+            return *this - other < 0;
+        }
+
+        bool operator >(const GrowableRingBufferIterator &other) const {
+            return *this - other > 0;
+        }
+
+        bool operator <=(const GrowableRingBufferIterator &other) const {
+            return *this - other <= 0;
+        }
+
+        bool operator >=(const GrowableRingBufferIterator &other) const {
+            return *this - other >= 0;
+        }
+
+        RefType operator [](difference_type diff) const {
+            return ringBuf_->arr_[(pos_ + diff) & ringBuf_->mask_];
+        }
+
+        friend RingBufferType;
+    };
+
+    Allocator allocator_;
+    T *arr_;
+    size_type mask_, head_, tail_;
+
+    size_type capacity_of(size_type n) const {
+        size_type capacity = MIN_CAPACITY;
+        while (capacity < n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    // Moves [head_, tail_) into a fresh array of the given capacity. The
+    // occupied part of the old array is at most two contiguous runs. The old
+    // elements are destroyed only after every one has been transferred, so a
+    // throwing copy leaves the buffer untouched.
+    void relocate(size_type capacity) {
+        T *arr = AllocTraits::allocate(allocator_, capacity);
+        size_type n = size();
+        if (arr_ != nullptr) {
+            size_type first = head_ & mask_;
+            size_type firstLen = std::min(n, mask_ + 1 - first);
+            try {
+                move_segment(arr_ + first, firstLen, arr);
+                try {
+                    move_segment(arr_, n - firstLen, arr + firstLen);
+                } catch (...) {
+                    destroy_segment(arr, firstLen);
+                    throw;
+                }
+            } catch (...) {
+                AllocTraits::deallocate(allocator_, arr, capacity);
+                throw;
+            }
+            destroy_segment(arr_ + first, firstLen);
+            destroy_segment(arr_, n - firstLen);
+            AllocTraits::deallocate(allocator_, arr_, mask_ + 1);
+        }
+        arr_ = arr;
+        mask_ = capacity - 1;
+        head_ = 0;
+        tail_ = n;
+    }
+
+    void move_segment(T *src, size_type n, T *dst) {
+        move_segment(src, n, dst, std::is_trivially_copyable<T>());
+    }
+
+    void move_segment(T *src, size_type n, T *dst, std::true_type) {
+        if (n != 0) {
+            std::memcpy(static_cast<void *>(dst), src, n * sizeof(T));
+        }
+    }
+
+    void move_segment(T *src, size_type n, T *dst, std::false_type) {
+        size_type i = 0;
+        try {
+            for (; i < n; ++i) {
+                AllocTraits::construct(allocator_, dst + i, std::move_if_noexcept(src[i]));
+            }
+        } catch (...) {
+            destroy_segment(dst, i);
+            throw;
+        }
+    }
+
+    void destroy_segment(T *ptr, size_type n) {
+        for (size_type i = 0; i < n; ++i) {
+            AllocTraits::destroy(allocator_, ptr + i);
+        }
+    }
+
+    bool needs_growth() const {
+        return arr_ == nullptr || size() == mask_ + 1;
+    }
+
+    void grow() {
+        relocate(arr_ == nullptr ? MIN_CAPACITY : 2 * (mask_ + 1));
+    }
+
+    void release() {
+        clear();
+        if (arr_ != nullptr) {
+            AllocTraits::deallocate(allocator_, arr_, mask_ + 1);
+            arr_ = nullptr;
+            mask_ = 0;
+        }
+    }
+
+    void copy(const GrowableRingBuffer &other) {
+        if (other.empty()) {
+            return;
+        }
+        relocate(capacity_of(other.size()));
+        for (size_type pos = other.head_; pos != other.tail_; ++pos) {
+            push_back(other.arr_[pos & other.mask_]);
+        }
+    }
+
+    void steal(GrowableRingBuffer &other) {
+        arr_ = other.arr_;
+        mask_ = other.mask_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        other.arr_ = nullptr;
+        other.mask_ = other.head_ = other.tail_ = 0;
+    }
+
+    void assign_allocator(const Allocator &other, std::true_type) {
+        allocator_ = other;
+    }
+
+    void assign_allocator(const Allocator &, std::false_type) {}
+
+    void move_allocator(Allocator &other, std::true_type) {
+        allocator_ = std::move(other);
+    }
+
+    void move_allocator(Allocator &, std::false_type) {}
+
+public:
+    typedef GrowableRingBufferIterator<value_type, reference, pointer, GrowableRingBuffer<T, Allocator>> iterator;
+    typedef GrowableRingBufferIterator<const value_type, const_reference, const_pointer, const GrowableRingBuffer<T, Allocator>> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    const static std::size_t MIN_CAPACITY = 16;
+
+    GrowableRingBuffer(const Allocator &allocator = Allocator()) :
+            allocator_(allocator),
+            arr_(nullptr),
+            mask_(0),
+            head_(0),
+            tail_(0)
+    {}
+
+    GrowableRingBuffer(const GrowableRingBuffer &other) :
+            allocator_(AllocTraits::select_on_container_copy_construction(other.allocator_)),
+            arr_(nullptr),
+            mask_(0),
+            head_(0),
+            tail_(0) {
+        copy(other);
+    }
+
+    GrowableRingBuffer(GrowableRingBuffer &&other) :
+            allocator_(std::move(other.allocator_)),
+            arr_(nullptr),
+            mask_(0),
+            head_(0),
+            tail_(0) {
+        steal(other);
+    }
+
+    GrowableRingBuffer &operator =(const GrowableRingBuffer &other) {
+        if (&other != this) {
+            release();
+            assign_allocator(other.allocator_,
+                             typename AllocTraits::propagate_on_container_copy_assignment());
+            copy(other);
+        }
+        return *this;
+    }
+
+    GrowableRingBuffer &operator =(GrowableRingBuffer &&other) {
+        if (&other == this) {
+            return *this;
+        }
+        release();
+        if (AllocTraits::propagate_on_container_move_assignment::value || allocator_ == other.allocator_) {
+            move_allocator(other.allocator_,
+                           typename AllocTraits::propagate_on_container_move_assignment());
+            steal(other);
+        } else {
+            copy(other);
+        }
+        return *this;
+    }
+
+    ~GrowableRingBuffer() {
+        release();
+    }
+
+    void swap(GrowableRingBuffer &other) {
+        if (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(allocator_, other.allocator_);
+        }
+        std::swap(arr_, other.arr_);
+        std::swap(mask_, other.mask_);
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+    }
+
+    void reserve(size_type n) {
+        if (n > capacity()) {
+            relocate(capacity_of(n));
+        }
+    }
+
+    void clear() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_type pos = head_; pos != tail_; ++pos) {
+                AllocTraits::destroy(allocator_, arr_ + (pos & mask_));
+            }
+        }
+        head_ = tail_ = 0;
+    }
+
+    bool empty() const {
+        return head_ == tail_;
+    }
+
+    size_type size() const {
+        return tail_ - head_;
+    }
+
+    size_type capacity() const {
+        return arr_ == nullptr ? 0 : mask_ + 1;
+    }
+
+    // val may be an element of this buffer, so it is taken out before
+    // growing relocates the elements.
+    void push_back(const T &val) {
+        if (needs_growth()) {
+            push_back(T(val));
+            return;
+        }
+        AllocTraits::construct(allocator_, arr_ + (tail_ & mask_), val);
+        ++tail_;
+    }
+
+    void push_back(T &&val) {
+        if (needs_growth()) {
+            T moved(std::move(val));
+            grow();
+            AllocTraits::construct(allocator_, arr_ + (tail_ & mask_), std::move(moved));
+        } else {
+            AllocTraits::construct(allocator_, arr_ + (tail_ & mask_), std::move(val));
+        }
+        ++tail_;
+    }
+
+    void push_front(const T &val) {
+        if (needs_growth()) {
+            push_front(T(val));
+            return;
+        }
+        AllocTraits::construct(allocator_, arr_ + ((head_ - 1) & mask_), val);
+        --head_;
+    }
+
+    void push_front(T &&val) {
+        if (needs_growth()) {
+            T moved(std::move(val));
+            grow();
+            AllocTraits::construct(allocator_, arr_ + ((head_ - 1) & mask_), std::move(moved));
+        } else {
+            AllocTraits::construct(allocator_, arr_ + ((head_ - 1) & mask_), std::move(val));
+        }
+        --head_;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("RingBuffer is already empty");
+        }
+        --tail_;
+        AllocTraits::destroy(allocator_, arr_ + (tail_ & mask_));
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::runtime_error("RingBuffer is already empty");
+        }
+        AllocTraits::destroy(allocator_, arr_ + (head_ & mask_));
+        ++head_;
+    }
+
+    T &operator [](size_type n) {
+        return arr_[(head_ + n) & mask_];
+    }
+
+    const T &operator [](size_type n) const {
+        return arr_[(head_ + n) & mask_];
+    }
+
+    T &front() {
+        return arr_[head_ & mask_];
+    }
+
+    const T &front() const {
+        return arr_[head_ & mask_];
+    }
+
+    T &back() {
+        return arr_[(tail_ - 1) & mask_];
+    }
+
+    const T &back() const {
+        return arr_[(tail_ - 1) & mask_];
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_;
+    }
+
+    iterator begin() {
+        return iterator(head_, this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(head_, this);
+    }
+
+    const_iterator cbegin() const {
+        return const_iterator(head_, this);
+    }
+
+    iterator end() {
+        return iterator(tail_, this);
+    }
+
+    const_iterator end() const {
+        return const_iterator(tail_, this);
+    }
+
+    const_iterator cend() const {
+        return const_iterator(tail_, this);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const {
+        return const_reverse_iterator(begin());
+    }
+};
+
+#endif //DEQUE_GROWABLERINGBUFFER_H
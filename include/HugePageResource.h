@@ -0,0 +1,138 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_HUGEPAGERESOURCE_H
+#define DEQUE_HUGEPAGERESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <utility>
+#include <sys/mman.h>
+
+#include "MemoryResource.h"
+
+// Carves cache-line aligned allocations out of 2 MiB regions that are
+// advised for transparent huge pages. Freed allocations are kept on per-size
+// free lists; regions are unmapped only when the resource is destroyed.
+class HugePageResource : public MemoryResource {
+public:
+    enum : std::size_t {
+        REGION_SIZE = 2 << 20,
+        CACHE_LINE = 64
+    };
+private:
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    std::vector<std::pair<void *, std::size_t>> regions_;
+    std::vector<std::pair<std::size_t, FreeNode *>> freeLists_;
+    char *cur_, *end_;
+
+    static std::size_t round_up(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static void *map(std::size_t size) {
+        // Over-map so that the region can be trimmed to a huge page boundary.
+        std::size_t mapped = size + REGION_SIZE;
+        void *raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char *begin = static_cast<char *>(raw);
+        char *aligned = reinterpret_cast<char *>(
+                round_up(reinterpret_cast<std::uintptr_t>(begin), REGION_SIZE));
+        if (aligned != begin) {
+            munmap(begin, aligned - begin);
+        }
+        char *end = begin + mapped;
+        if (aligned + size != end) {
+            munmap(aligned + size, end - (aligned + size));
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+        return aligned;
+    }
+
+    FreeNode *&free_list(std::size_t size) {
+        for (auto &list : freeLists_) {
+            if (list.first == size) {
+                return list.second;
+            }
+        }
+        freeLists_.push_back(std::make_pair(size, static_cast<FreeNode *>(nullptr)));
+        return freeLists_.back().second;
+    }
+
+public:
+    HugePageResource() : cur_(nullptr), end_(nullptr) {}
+
+    HugePageResource(const HugePageResource &) = delete;
+    HugePageResource &operator =(const HugePageResource &) = delete;
+
+    ~HugePageResource() {
+        for (auto &region : regions_) {
+            munmap(region.first, region.second);
+        }
+    }
+
+    std::size_t regions_count() const {
+        return regions_.size();
+    }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > CACHE_LINE) {
+            throw std::bad_alloc();
+        }
+        std::size_t size = round_up(bytes == 0 ? 1 : bytes, CACHE_LINE);
+        if (size > REGION_SIZE / 2) {
+            size = round_up(size, REGION_SIZE);
+            void *ptr = map(size);
+            regions_.push_back(std::make_pair(ptr, size));
+            return ptr;
+        }
+
+        FreeNode *&head = free_list(size);
+        if (head != nullptr) {
+            FreeNode *node = head;
+            head = node->next;
+            return node;
+        }
+
+        if (cur_ == nullptr || cur_ + size > end_) {
+            cur_ = static_cast<char *>(map(REGION_SIZE));
+            end_ = cur_ + REGION_SIZE;
+            regions_.push_back(std::make_pair(static_cast<void *>(cur_), REGION_SIZE));
+        }
+        void *ptr = cur_;
+        cur_ += size;
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, std::size_t bytes, std::size_t) override {
+        std::size_t size = round_up(bytes == 0 ? 1 : bytes, CACHE_LINE);
+        if (size > REGION_SIZE / 2) {
+            size = round_up(size, REGION_SIZE);
+            for (auto it = regions_.begin(); it != regions_.end(); ++it) {
+                if (it->first == ptr) {
+                    munmap(ptr, size);
+                    regions_.erase(it);
+                    return;
+                }
+            }
+            return;
+        }
+        FreeNode *&head = free_list(size);
+        FreeNode *node = static_cast<FreeNode *>(ptr);
+        node->next = head;
+        head = node;
+    }
+};
+
+#endif //DEQUE_HUGEPAGERESOURCE_H
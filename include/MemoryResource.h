@@ -0,0 +1,175 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_MEMORYRESOURCE_H
+#define DEQUE_MEMORYRESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+
+// A small C++11 counterpart of std::pmr: containers parameterized with
+// PolymorphicAllocator<T> take their memory from whatever MemoryResource
+// they were given.
+class MemoryResource {
+public:
+    virtual ~MemoryResource() {}
+
+    void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void *ptr, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        do_deallocate(ptr, bytes, alignment);
+    }
+
+    bool is_equal(const MemoryResource &other) const noexcept {
+        return do_is_equal(other);
+    }
+
+protected:
+    virtual void *do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) = 0;
+
+    virtual bool do_is_equal(const MemoryResource &other) const noexcept {
+        return this == &other;
+    }
+};
+
+class NewDeleteResource : public MemoryResource {
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t) override {
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void *ptr, std::size_t, std::size_t) override {
+        ::operator delete(ptr);
+    }
+};
+
+inline MemoryResource *new_delete_resource() {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+// Bump-pointer arena. deallocate() is a no-op; everything is returned to the
+// upstream resource at once by release() or by the destructor.
+class MonotonicArena : public MemoryResource {
+private:
+    struct Chunk {
+        Chunk *next;
+        std::size_t size;
+    };
+
+    MemoryResource *upstream_;
+    Chunk *chunks_;
+    char *cur_, *end_;
+    std::size_t nextChunkSize_, bytesAllocated_;
+
+    void add_chunk(std::size_t minSize) {
+        std::size_t size = std::max(nextChunkSize_, minSize + sizeof(Chunk));
+        Chunk *chunk = static_cast<Chunk *>(upstream_->allocate(size));
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        cur_ = reinterpret_cast<char *>(chunk + 1);
+        end_ = reinterpret_cast<char *>(chunk) + size;
+        nextChunkSize_ = 2 * size;
+    }
+
+    static char *align_up(char *ptr, std::size_t alignment) {
+        std::uintptr_t value = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + ((alignment - value % alignment) % alignment);
+    }
+
+public:
+    explicit MonotonicArena(std::size_t initialChunkSize = 4096,
+                            MemoryResource *upstream = new_delete_resource()) :
+            upstream_(upstream),
+            chunks_(nullptr),
+            cur_(nullptr),
+            end_(nullptr),
+            nextChunkSize_(initialChunkSize),
+            bytesAllocated_(0)
+    {}
+
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator =(const MonotonicArena &) = delete;
+
+    ~MonotonicArena() {
+        release();
+    }
+
+    void release() {
+        while (chunks_ != nullptr) {
+            Chunk *next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->size);
+            chunks_ = next;
+        }
+        cur_ = end_ = nullptr;
+        bytesAllocated_ = 0;
+    }
+
+    std::size_t bytes_allocated() const {
+        return bytesAllocated_;
+    }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        char *ptr = align_up(cur_, alignment);
+        if (cur_ == nullptr || ptr + bytes > end_) {
+            add_chunk(bytes + alignment);
+            ptr = align_up(cur_, alignment);
+        }
+        cur_ = ptr + bytes;
+        bytesAllocated_ += bytes;
+        return ptr;
+    }
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+};
+
+template <class T>
+class PolymorphicAllocator {
+private:
+    MemoryResource *resource_;
+public:
+    typedef T value_type;
+
+    PolymorphicAllocator() : resource_(new_delete_resource()) {}
+
+    PolymorphicAllocator(MemoryResource *resource) : resource_(resource) {}
+
+    template <class U>
+    PolymorphicAllocator(const PolymorphicAllocator<U> &other) : resource_(other.resource()) {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n) {
+        resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    MemoryResource *resource() const {
+        return resource_;
+    }
+
+    PolymorphicAllocator select_on_container_copy_construction() const {
+        return PolymorphicAllocator();
+    }
+};
+
+template <class T, class U>
+bool operator ==(const PolymorphicAllocator<T> &a, const PolymorphicAllocator<U> &b) {
+    return a.resource() == b.resource() || a.resource()->is_equal(*b.resource());
+}
+
+template <class T, class U>
+bool operator !=(const PolymorphicAllocator<T> &a, const PolymorphicAllocator<U> &b) {
+    return !(a == b);
+}
+
+#endif //DEQUE_MEMORYRESOURCE_H
@@ -0,0 +1,201 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_RECORDDEQUE_H
+#define DEQUE_RECORDDEQUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "Deque.h"
+
+// Queue of variable-length byte records packed back to back into a
+// Deque<char>, each preceded by a 4-byte length. A record may span blocks,
+// so it is exposed as a Record view over one or more segments; pushing and
+// popping a record does not allocate apart from the blocks themselves.
+class RecordDeque {
+public:
+    typedef Deque<char>::const_segment_range const_segment_range;
+
+    enum : std::size_t {
+        HEADER_SIZE = sizeof(std::uint32_t)
+    };
+
+    class Record {
+    private:
+        const Deque<char> *bytes_;
+        std::size_t pos_, size_;
+        Record(const Deque<char> *bytes, std::size_t pos, std::size_t size) :
+                bytes_(bytes), pos_(pos), size_(size)
+        {}
+    public:
+        std::size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        // The record's bytes, one segment per block it touches.
+        const_segment_range segments() const {
+            return bytes_->segments(bytes_->begin() + pos_, bytes_->begin() + (pos_ + size_));
+        }
+
+        // Pointer to the bytes if they are contiguous, nullptr otherwise.
+        const char *data() const {
+            const_segment_range range = segments();
+            return range.size() == 1 ? (*range.begin()).data() : nullptr;
+        }
+
+        void copy(void *out) const {
+            char *dst = static_cast<char *>(out);
+            for (auto segment : segments()) {
+                std::memcpy(dst, segment.data(), segment.size());
+                dst += segment.size();
+            }
+        }
+
+        std::string str() const {
+            std::string ans(size_, '\0');
+            if (size_ != 0) {
+                copy(&ans[0]);
+            }
+            return ans;
+        }
+
+        friend class RecordDeque;
+    };
+
+    class const_iterator : public std::iterator<std::forward_iterator_tag, Record,
+            std::ptrdiff_t, const Record *, Record> {
+    private:
+        const RecordDeque *records_;
+        std::size_t pos_;
+        const_iterator(const RecordDeque *records, std::size_t pos) : records_(records), pos_(pos) {}
+    public:
+        const_iterator() : records_(nullptr), pos_(0) {}
+
+        bool operator ==(const const_iterator &other) const {
+            return records_ == other.records_ && pos_ == other.pos_;
+        }
+
+        bool operator !=(const const_iterator &other) const {
+            return !operator==(other);
+        }
+
+        Record operator *() const {
+            return records_->record_at(pos_);
+        }
+
+        const_iterator &operator ++() {
+            pos_ += HEADER_SIZE + records_->length_at(pos_);
+            return *this;
+        }
+
+        const const_iterator operator ++(int) {
+            const_iterator ans = *this;
+            ++(*this);
+            return ans;
+        }
+
+        friend class RecordDeque;
+    };
+
+private:
+    Deque<char> bytes_;
+    std::size_t count_;
+
+    std::uint32_t length_at(std::size_t pos) const {
+        char header[HEADER_SIZE];
+        char *dst = header;
+        for (auto segment : bytes_.segments(bytes_.begin() + pos, bytes_.begin() + (pos + HEADER_SIZE))) {
+            std::memcpy(dst, segment.data(), segment.size());
+            dst += segment.size();
+        }
+        std::uint32_t length;
+        std::memcpy(&length, header, HEADER_SIZE);
+        return length;
+    }
+
+    Record record_at(std::size_t pos) const {
+        return Record(&bytes_, pos + HEADER_SIZE, length_at(pos));
+    }
+
+    // Copies n bytes over the tail starting at pos, which must already exist.
+    void write_at(std::size_t pos, const char *src, std::size_t n) {
+        for (auto segment : bytes_.segments(bytes_.begin() + pos, bytes_.begin() + (pos + n))) {
+            std::memcpy(segment.data(), src, segment.size());
+            src += segment.size();
+        }
+    }
+
+public:
+    RecordDeque() : count_(0) {}
+
+    void push_back(const void *data, std::size_t n) {
+        if (n > UINT32_MAX) {
+            throw std::runtime_error("Record is too long");
+        }
+        std::uint32_t length = static_cast<std::uint32_t>(n);
+        char header[HEADER_SIZE];
+        std::memcpy(header, &length, HEADER_SIZE);
+        std::size_t pos = bytes_.size();
+        bytes_.grow_back(HEADER_SIZE + n);
+        write_at(pos, header, HEADER_SIZE);
+        write_at(pos + HEADER_SIZE, static_cast<const char *>(data), n);
+        ++count_;
+    }
+
+    void push_back(const std::string &record) {
+        push_back(record.data(), record.size());
+    }
+
+    Record front_record() const {
+        if (empty()) {
+            throw std::runtime_error("RecordDeque is empty");
+        }
+        return record_at(0);
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::runtime_error("RecordDeque is already empty");
+        }
+        bytes_.pop_front_n(HEADER_SIZE + length_at(0));
+        --count_;
+    }
+
+    std::size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    // Total bytes stored, headers included.
+    std::size_t bytes_size() const {
+        return bytes_.size();
+    }
+
+    void clear() {
+        bytes_.pop_front_n(bytes_.size());
+        count_ = 0;
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, bytes_.size());
+    }
+};
+
+#endif //DEQUE_RECORDDEQUE_H
@@ -9,18 +9,23 @@
 #include <algorithm>
 #include <memory>
 #include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 template <class T, class Allocator = std::allocator<T>>
 class RingBuffer {
 public:
     typedef T value_type;
     typedef Allocator allocator_type;
-    typedef typename allocator_type::reference reference;
-    typedef typename allocator_type::const_reference const_reference;
-    typedef typename allocator_type::pointer pointer;
-    typedef typename allocator_type::const_pointer const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef typename std::allocator_traits<Allocator>::pointer pointer;
+    typedef typename std::allocator_traits<Allocator>::const_pointer const_pointer;
     typedef std::size_t size_type;
 private:
+    typedef std::allocator_traits<Allocator> AllocTraits;
+
     Allocator allocator_;
     T *arr_, *begin_, *end_;
     std::size_t size_, allocSize_;
@@ -32,19 +37,35 @@ private:
         }
     }
 
-    template <class Alloc2>
-    void copy(const RingBuffer<T, Alloc2> &other) {
+    void copy(const RingBuffer &other) {
         reset();
         size_ = other.size_;
         allocSize_ = other.allocSize_;
-        arr_ = allocator_.allocate(allocSize_);
+        arr_ = allocSize_ == 0 ? nullptr : allocator_.allocate(allocSize_);
         begin_ = end_ = arr_;
         for (std::size_t i = 0; i < size_; ++i) {
             *end_++ = other[i];
         }
+        if (static_cast<size_type>(end_ - arr_) == allocSize_) {
+            end_ = arr_;
+        }
+    }
+
+    void assign_allocator(const Allocator &other, std::true_type) {
+        allocator_ = other;
     }
+
+    void assign_allocator(const Allocator &, std::false_type) {}
+#if __cplusplus >= 201703L && defined(__GNUC__)
+// std::iterator is deprecated since C++17; the base only supplies typedefs.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
     template <class IterType, class RefType, class PtrType, class RingBufferType>
     class RingBufferIterator : public std::iterator<std::random_access_iterator_tag, IterType> {
+#if __cplusplus >= 201703L && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
     public:
         typedef std::ptrdiff_t difference_type;
     private:
@@ -205,10 +226,12 @@ public:
     typedef std::reverse_iterator<iterator> reverse_iterator;
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
     typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+    typedef std::pair<T *, std::size_t> array_range;
+    typedef std::pair<const T *, std::size_t> const_array_range;
 
     RingBuffer(std::size_t size, const Allocator allocator = Allocator()) :
             allocator_(allocator),
-            arr_(allocator_.allocate(size)),
+            arr_(size == 0 ? nullptr : allocator_.allocate(size)),
             begin_(arr_),
             end_(arr_),
             size_(0),
@@ -217,16 +240,18 @@ public:
         reset();
     }
 
-    template <class Alloc2>
-    RingBuffer(const RingBuffer<T, Alloc2> &other) : allocator_(Allocator()), arr_(nullptr) {
+    RingBuffer(const RingBuffer &other) :
+            allocator_(AllocTraits::select_on_container_copy_construction(other.allocator_)),
+            arr_(nullptr) {
         copy(other);
     }
 
-    template <class Alloc2>
-    RingBuffer<T, Allocator> &operator =(const RingBuffer<T, Alloc2> &other) {
-        if (arr_ == other.arr_) {
+    RingBuffer &operator =(const RingBuffer &other) {
+        if (this == &other) {
             return *this;
         }
+        reset();
+        assign_allocator(other.allocator_, typename AllocTraits::propagate_on_container_copy_assignment());
         copy(other);
         return *this;
     }
@@ -242,7 +267,7 @@ public:
 
     void reset_and_resize(std::size_t n) {
         reset();
-        end_ = begin_ = arr_ = allocator_.allocate(n);
+        end_ = begin_ = arr_ = (n == 0 ? nullptr : allocator_.allocate(n));
         size_ = 0;
         allocSize_ = n;
     }
@@ -269,11 +294,26 @@ public:
         }
         *end_++ = val;
         ++size_;
-        if (end_ - arr_ == allocSize_) {
+        if (static_cast<size_type>(end_ - arr_) == allocSize_) {
             end_ = arr_;
         }
     }
 
+    void push_back_overwrite(const T &val) {
+        if (!full()) {
+            push_back(val);
+            return;
+        }
+        if (allocSize_ == 0) {
+            return;
+        }
+        *end_++ = val;
+        if (static_cast<size_type>(end_ - arr_) == allocSize_) {
+            end_ = arr_;
+        }
+        begin_ = end_;
+    }
+
     void push_front(const T &val) {
         if (full()) {
             return;
@@ -302,14 +342,71 @@ public:
         }
         ++begin_;
         --size_;
-        if (begin_ - arr_ == allocSize_) {
+        if (static_cast<size_type>(begin_ - arr_) == allocSize_) {
+            begin_ = arr_;
+        }
+    }
+
+    std::size_t push_back_n(const T *src, std::size_t n) {
+        n = std::min(n, allocSize_ - size_);
+        std::size_t first = std::min(n, static_cast<std::size_t>(arr_ + allocSize_ - end_));
+        std::copy(src, src + first, end_);
+        std::copy(src + first, src + n, arr_);
+        end_ = first < n ? arr_ + (n - first) : end_ + n;
+        if (static_cast<size_type>(end_ - arr_) == allocSize_) {
+            end_ = arr_;
+        }
+        size_ += n;
+        return n;
+    }
+
+    std::size_t peek(T *out, std::size_t n) const {
+        n = std::min(n, size_);
+        std::size_t first = std::min(n, static_cast<std::size_t>(arr_ + allocSize_ - begin_));
+        std::copy(begin_, begin_ + first, out);
+        std::copy(arr_, arr_ + (n - first), out + first);
+        return n;
+    }
+
+    std::size_t pop_front_n(T *out, std::size_t n) {
+        n = peek(out, n);
+        std::size_t first = std::min(n, static_cast<std::size_t>(arr_ + allocSize_ - begin_));
+        begin_ = first < n ? arr_ + (n - first) : begin_ + n;
+        if (static_cast<size_type>(begin_ - arr_) == allocSize_) {
+            begin_ = arr_;
+        }
+        size_ -= n;
+        return n;
+    }
+
+    array_range array_one() {
+        return array_range(begin_, std::min(size_, static_cast<std::size_t>(arr_ + allocSize_ - begin_)));
+    }
+
+    const_array_range array_one() const {
+        return const_array_range(begin_, std::min(size_, static_cast<std::size_t>(arr_ + allocSize_ - begin_)));
+    }
+
+    array_range array_two() {
+        return array_range(arr_, size_ - array_one().second);
+    }
+
+    const_array_range array_two() const {
+        return const_array_range(arr_, size_ - array_one().second);
+    }
+
+    T *linearize() {
+        if (array_two().second != 0) {
+            std::rotate(arr_, begin_, arr_ + allocSize_);
             begin_ = arr_;
+            end_ = full() ? arr_ : arr_ + size_;
         }
+        return begin_;
     }
 
     T &operator [](std::size_t n) {
         T *ptr = begin_ + n;
-        if (ptr - arr_ >= allocSize_) {
+        if (static_cast<size_type>(ptr - arr_) >= allocSize_) {
             ptr -= allocSize_;
         }
         return *ptr;
@@ -317,7 +414,7 @@ public:
 
     const T &operator [](std::size_t n) const {
         T *ptr = begin_ + n;
-        if (ptr - arr_ >= allocSize_) {
+        if (static_cast<size_type>(ptr - arr_) >= allocSize_) {
             ptr -= allocSize_;
         }
         return *ptr;
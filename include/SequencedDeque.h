@@ -0,0 +1,245 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SEQUENCEDDEQUE_H
+#define DEQUE_SEQUENCEDDEQUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+#include "Deque.h"
+
+// Deque addressed by absolute sequence numbers, as in a retransmission
+// window: push_back assigns the next number, and the number of the front
+// element keeps growing as acknowledged elements are dropped. Arithmetic is
+// modulo 2^64, so the numbers may wrap.
+template <class T>
+class SequencedDeque {
+public:
+    typedef T value_type;
+    typedef std::uint64_t seq_type;
+    typedef typename Deque<T>::size_type size_type;
+private:
+    template <class IterType, class DequeIterType>
+    class SeqIterator : public std::iterator<std::random_access_iterator_tag, IterType> {
+    public:
+        typedef std::ptrdiff_t difference_type;
+    private:
+        DequeIterType it_;
+        seq_type seq_;
+        SeqIterator(DequeIterType it, seq_type seq) : it_(it), seq_(seq) {}
+    public:
+        SeqIterator() : seq_(0) {}
+
+        seq_type seq() const {
+            return seq_;
+        }
+
+        bool operator ==(const SeqIterator &other) const {
+            return it_ == other.it_;
+        }
+
+        bool operator !=(const SeqIterator &other) const {
+            return it_ != other.it_;
+        }
+
+        IterType &operator *() const {
+            return *it_;
+        }
+
+        IterType *operator ->() const {
+            return &*it_;
+        }
+
+        SeqIterator &operator ++() {
+            ++it_;
+            ++seq_;
+            return *this;
+        }
+
+        const SeqIterator operator ++(int) {
+            SeqIterator ans = *this;
+            ++(*this);
+            return ans;
+        }
+
+        SeqIterator &operator --() {
+            --it_;
+            --seq_;
+            return *this;
+        }
+
+        const SeqIterator operator --(int) {
+            SeqIterator ans = *this;
+            --(*this);
+            return ans;
+        }
+
+        SeqIterator &operator +=(difference_type diff) {
+            it_ += diff;
+            seq_ += diff;
+            return *this;
+        }
+
+        SeqIterator &operator -=(difference_type diff) {
+            it_ -= diff;
+            seq_ -= diff;
+            return *this;
+        }
+
+        const SeqIterator operator +(difference_type diff) const {
+            SeqIterator ans = *this;
+            ans += diff;
+            return ans;
+        }
+
+        const SeqIterator operator -(difference_type diff) const {
+            SeqIterator ans = *this;
+            ans -= diff;
+            return ans;
+        }
+
+        difference_type operator -(const SeqIterator &other) const {
+            return it_ - other.it_;
+        }
+
+        bool operator <(const SeqIterator &other) const {
+            return it_ < other.it_;
+        }
+
+        bool operator >(const SeqIterator &other) const {
+            return other < *this;
+        }
+
+        bool operator <=(const SeqIterator &other) const {
+            return !(other < *this);
+        }
+
+        bool operator >=(const SeqIterator &other) const {
+            return !(*this < other);
+        }
+
+        IterType &operator [](difference_type diff) const {
+            return it_[diff];
+        }
+
+        friend class SequencedDeque<T>;
+    };
+
+    Deque<T> deque_;
+    seq_type frontSeq_;
+
+    size_type offset_of(seq_type seq) const {
+        if (!contains_seq(seq)) {
+            throw std::runtime_error("Sequence number is out of the window");
+        }
+        return static_cast<size_type>(seq - frontSeq_);
+    }
+
+public:
+    typedef SeqIterator<T, typename Deque<T>::iterator> iterator;
+    typedef SeqIterator<const T, typename Deque<T>::const_iterator> const_iterator;
+
+    explicit SequencedDeque(seq_type firstSeq = 0) : frontSeq_(firstSeq) {}
+
+    // Sequence number of the front element (of the next pushed one if empty).
+    seq_type front_seq() const {
+        return frontSeq_;
+    }
+
+    seq_type next_seq() const {
+        return frontSeq_ + deque_.size();
+    }
+
+    bool contains_seq(seq_type seq) const {
+        return seq - frontSeq_ < deque_.size();
+    }
+
+    T &at_seq(seq_type seq) {
+        return deque_.at(offset_of(seq));
+    }
+
+    const T &at_seq(seq_type seq) const {
+        return deque_.at(offset_of(seq));
+    }
+
+    seq_type push_back(const T &value) {
+        deque_.push_back(value);
+        return next_seq() - 1;
+    }
+
+    void pop_front() {
+        deque_.pop_front();
+        ++frontSeq_;
+    }
+
+    void pop_back() {
+        deque_.pop_back();
+    }
+
+    // Drops every element up to and including seq. Whole blocks are
+    // released at once. Returns the number of elements dropped: 0 for a
+    // duplicate or stale ack below the front. Acks beyond the back throw.
+    size_type ack_through(seq_type seq) {
+        if (static_cast<std::int64_t>(seq - frontSeq_) < 0) {
+            return 0;
+        }
+        size_type n = offset_of(seq) + 1;
+        deque_.pop_front_n(n);
+        frontSeq_ += n;
+        return n;
+    }
+
+    T &front() {
+        return deque_.front();
+    }
+
+    const T &front() const {
+        return deque_.front();
+    }
+
+    T &back() {
+        return deque_.back();
+    }
+
+    const T &back() const {
+        return deque_.back();
+    }
+
+    bool empty() const {
+        return deque_.empty();
+    }
+
+    size_type size() const {
+        return deque_.size();
+    }
+
+    iterator find_seq(seq_type seq) {
+        return iterator(deque_.begin() + offset_of(seq), seq);
+    }
+
+    const_iterator find_seq(seq_type seq) const {
+        return const_iterator(deque_.begin() + offset_of(seq), seq);
+    }
+
+    iterator begin() {
+        return iterator(deque_.begin(), frontSeq_);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(deque_.begin(), frontSeq_);
+    }
+
+    iterator end() {
+        return iterator(deque_.end(), next_seq());
+    }
+
+    const_iterator end() const {
+        return const_iterator(deque_.end(), next_seq());
+    }
+};
+
+#endif //DEQUE_SEQUENCEDDEQUE_H
@@ -0,0 +1,358 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SHAREDRINGBUFFER_H
+#define DEQUE_SHAREDRINGBUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// Single-producer/single-consumer ring placed in shared memory, for passing
+// trivially copyable values between processes. The region holds only a
+// header and the slots, no pointers: each process addresses the slots by
+// offset from wherever it mapped the region. head and tail are free-running
+// counters on separate cache lines; each side also caches the other side's
+// counter and re-reads it only when the cached value does not suffice.
+//
+// try_push/try_pop never block. push/pop spin briefly and then sleep on a
+// futex; the other side issues the wake-up only if someone is sleeping, so
+// the non-blocking path pays a fence and a load for it. With Wakeup = false
+// that is dropped too, and push/pop spin with sched_yield() instead.
+template <class T, bool Wakeup = true>
+class SharedRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "SharedRingBuffer requires trivially copyable elements");
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+                  "SharedRingBuffer requires lock-free atomics");
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    enum : std::size_t {
+        CACHE_LINE = 64,
+        SPIN = 256
+    };
+private:
+    static const std::uint64_t MAGIC = 0x5348524e47425546ull;
+
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t capacity;
+        std::uint64_t elementSize;
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> head;
+        alignas(CACHE_LINE) std::atomic<std::uint64_t> tail;
+        // Bumped to wake the consumer (producer) sleeping on it.
+        alignas(CACHE_LINE) std::atomic<std::uint32_t> dataSeq;
+        std::atomic<std::uint32_t> consumerWaiting;
+        alignas(CACHE_LINE) std::atomic<std::uint32_t> spaceSeq;
+        std::atomic<std::uint32_t> producerWaiting;
+    };
+
+    char *base_;
+    std::size_t mappedSize_;
+    Header *header_;
+    T *data_;
+    std::uint64_t mask_;
+    std::uint64_t cachedHead_, cachedTail_;
+
+    static std::size_t pow2_of(std::size_t n) {
+        std::size_t ans = 1;
+        while (ans < n) {
+            ans *= 2;
+        }
+        return ans;
+    }
+
+    static std::size_t region_size(std::size_t capacity) {
+        return sizeof(Header) + capacity * sizeof(T);
+    }
+
+    static char *map(int fd, std::size_t size) {
+        int flags = fd == -1 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED;
+        void *raw = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (raw == MAP_FAILED) {
+            throw std::runtime_error(std::string("mmap failed: ") + std::strerror(errno));
+        }
+        return static_cast<char *>(raw);
+    }
+
+    static void init(char *base, std::size_t capacity) {
+        Header *header = ::new (static_cast<void *>(base)) Header();
+        header->magic = MAGIC;
+        header->capacity = capacity;
+        header->elementSize = sizeof(T);
+        header->head.store(0, std::memory_order_relaxed);
+        header->tail.store(0, std::memory_order_relaxed);
+        header->dataSeq.store(0, std::memory_order_relaxed);
+        header->consumerWaiting.store(0, std::memory_order_relaxed);
+        header->spaceSeq.store(0, std::memory_order_relaxed);
+        header->producerWaiting.store(0, std::memory_order_release);
+    }
+
+    SharedRingBuffer(char *base, std::size_t mappedSize) :
+            base_(base),
+            mappedSize_(mappedSize),
+            header_(reinterpret_cast<Header *>(base)),
+            data_(reinterpret_cast<T *>(base + sizeof(Header))),
+            mask_(header_->capacity - 1),
+            cachedHead_(header_->head.load(std::memory_order_acquire)),
+            cachedTail_(header_->tail.load(std::memory_order_acquire))
+    {}
+
+    static void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t expected) {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+        (void) word;
+        (void) expected;
+        sched_yield();
+#endif
+    }
+
+    static void futex_wake(std::atomic<std::uint32_t> &word) {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+        (void) word;
+#endif
+    }
+
+    // Sleeps until ready() holds. Announcing the waiter and re-checking
+    // ready() are ordered against the other side's update and its check of
+    // the flag by seq_cst fences, so a wake-up cannot be lost.
+    template <class Ready>
+    static void wait(std::atomic<std::uint32_t> &seq, std::atomic<std::uint32_t> &waiting, Ready ready) {
+        for (std::size_t i = 0; i < SPIN; ++i) {
+            if (ready()) {
+                return;
+            }
+        }
+        if (!Wakeup) {
+            while (!ready()) {
+                sched_yield();
+            }
+            return;
+        }
+        while (true) {
+            std::uint32_t current = seq.load(std::memory_order_relaxed);
+            waiting.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                break;
+            }
+            futex_wait(seq, current);
+        }
+        waiting.store(0, std::memory_order_relaxed);
+    }
+
+    static void notify(std::atomic<std::uint32_t> &seq, std::atomic<std::uint32_t> &waiting) {
+        if (!Wakeup) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) != 0) {
+            seq.fetch_add(1, std::memory_order_relaxed);
+            futex_wake(seq);
+        }
+    }
+
+    // Re-reads the other side's counter only if the cached one does not
+    // leave room for (hold) wanted elements.
+    std::size_t free_space(std::uint64_t tail, std::size_t wanted) {
+        std::uint64_t capacity = mask_ + 1;
+        if (capacity - (tail - cachedHead_) < wanted) {
+            cachedHead_ = header_->head.load(std::memory_order_acquire);
+        }
+        return capacity - (tail - cachedHead_);
+    }
+
+    std::size_t available(std::uint64_t head, std::size_t wanted) {
+        if (cachedTail_ - head < wanted) {
+            cachedTail_ = header_->tail.load(std::memory_order_acquire);
+        }
+        return cachedTail_ - head;
+    }
+
+public:
+    // Creates and maps a new named region; fails if the name is taken.
+    static SharedRingBuffer create(const std::string &name, std::size_t capacity) {
+        capacity = pow2_of(std::max<std::size_t>(capacity, 1));
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd == -1) {
+            throw std::runtime_error(std::string("shm_open failed: ") + std::strerror(errno));
+        }
+        std::size_t size = region_size(capacity);
+        if (ftruncate(fd, size) == -1) {
+            int error = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error(std::string("ftruncate failed: ") + std::strerror(error));
+        }
+        char *base;
+        try {
+            base = map(fd, size);
+        } catch (...) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw;
+        }
+        close(fd);
+        init(base, capacity);
+        return SharedRingBuffer(base, size);
+    }
+
+    // Maps a region made by create() in this or another process.
+    static SharedRingBuffer open(const std::string &name) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd == -1) {
+            throw std::runtime_error(std::string("shm_open failed: ") + std::strerror(errno));
+        }
+        struct stat st;
+        if (fstat(fd, &st) == -1 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+            close(fd);
+            throw std::runtime_error("Shared region is too small");
+        }
+        char *base;
+        try {
+            base = map(fd, st.st_size);
+        } catch (...) {
+            close(fd);
+            throw;
+        }
+        close(fd);
+        const Header *header = reinterpret_cast<const Header *>(base);
+        if (header->magic != MAGIC || header->elementSize != sizeof(T) ||
+                region_size(header->capacity) > static_cast<std::size_t>(st.st_size)) {
+            munmap(base, st.st_size);
+            throw std::runtime_error("Shared region holds a different ring");
+        }
+        return SharedRingBuffer(base, st.st_size);
+    }
+
+    // Anonymous shared mapping, inherited by children created with fork().
+    static SharedRingBuffer anonymous(std::size_t capacity) {
+        capacity = pow2_of(std::max<std::size_t>(capacity, 1));
+        std::size_t size = region_size(capacity);
+        char *base = map(-1, size);
+        init(base, capacity);
+        return SharedRingBuffer(base, size);
+    }
+
+    static void unlink(const std::string &name) {
+        shm_unlink(name.c_str());
+    }
+
+    SharedRingBuffer(SharedRingBuffer &&other) :
+            base_(other.base_),
+            mappedSize_(other.mappedSize_),
+            header_(other.header_),
+            data_(other.data_),
+            mask_(other.mask_),
+            cachedHead_(other.cachedHead_),
+            cachedTail_(other.cachedTail_) {
+        other.base_ = nullptr;
+    }
+
+    SharedRingBuffer(const SharedRingBuffer &) = delete;
+    SharedRingBuffer &operator =(const SharedRingBuffer &) = delete;
+
+    ~SharedRingBuffer() {
+        if (base_ != nullptr) {
+            munmap(base_, mappedSize_);
+        }
+    }
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    // Exact only when called by the producer or the consumer.
+    std::size_t size() const {
+        std::uint64_t head = header_->head.load(std::memory_order_acquire);
+        return header_->tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Producer side.
+    std::size_t push_back_n(const T *src, std::size_t n) {
+        std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        n = std::min(n, free_space(tail, n));
+        if (n == 0) {
+            return 0;
+        }
+        std::size_t offset = tail & mask_;
+        std::size_t first = std::min<std::size_t>(n, capacity() - offset);
+        std::memcpy(static_cast<void *>(data_ + offset), src, first * sizeof(T));
+        std::memcpy(static_cast<void *>(data_), src + first, (n - first) * sizeof(T));
+        header_->tail.store(tail + n, std::memory_order_release);
+        notify(header_->dataSeq, header_->consumerWaiting);
+        return n;
+    }
+
+    bool try_push(const T &value) {
+        return push_back_n(&value, 1) == 1;
+    }
+
+    void push(const T &value) {
+        while (!try_push(value)) {
+            std::uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+            wait(header_->spaceSeq, header_->producerWaiting, [this, tail]() {
+                return free_space(tail, 1) != 0;
+            });
+        }
+    }
+
+    // Consumer side.
+    std::size_t pop_front_n(T *out, std::size_t n) {
+        std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+        n = std::min(n, available(head, n));
+        if (n == 0) {
+            return 0;
+        }
+        std::size_t offset = head & mask_;
+        std::size_t first = std::min<std::size_t>(n, capacity() - offset);
+        std::memcpy(static_cast<void *>(out), data_ + offset, first * sizeof(T));
+        std::memcpy(static_cast<void *>(out + first), data_, (n - first) * sizeof(T));
+        header_->head.store(head + n, std::memory_order_release);
+        notify(header_->spaceSeq, header_->producerWaiting);
+        return n;
+    }
+
+    bool try_pop(T &out) {
+        return pop_front_n(&out, 1) == 1;
+    }
+
+    void pop(T &out) {
+        while (!try_pop(out)) {
+            std::uint64_t head = header_->head.load(std::memory_order_relaxed);
+            wait(header_->dataSeq, header_->consumerWaiting, [this, head]() {
+                return available(head, 1) != 0;
+            });
+        }
+    }
+};
+
+template <class T, bool Wakeup>
+const std::uint64_t SharedRingBuffer<T, Wakeup>::MAGIC;
+
+#endif //DEQUE_SHAREDRINGBUFFER_H
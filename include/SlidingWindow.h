@@ -0,0 +1,251 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SLIDINGWINDOW_H
+#define DEQUE_SLIDINGWINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "Deque.h"
+
+template <class T>
+struct SumMonoid {
+    T identity() const {
+        return T();
+    }
+
+    T operator ()(const T &a, const T &b) const {
+        return a + b;
+    }
+};
+
+template <class T>
+struct MinMonoid {
+    T identity() const {
+        return std::numeric_limits<T>::max();
+    }
+
+    T operator ()(const T &a, const T &b) const {
+        return b < a ? b : a;
+    }
+};
+
+template <class T>
+struct MaxMonoid {
+    T identity() const {
+        return std::numeric_limits<T>::lowest();
+    }
+
+    T operator ()(const T &a, const T &b) const {
+        return a < b ? b : a;
+    }
+};
+
+// Sliding minimum (or maximum with std::greater) over a FIFO window. Only
+// the candidates that can still become the extremum are kept, in a Deque
+// ordered by arrival. push() is amortized O(1), pop() and top() are O(1).
+template <class T, class Compare = std::less<T>>
+class MonotonicWindow {
+private:
+    struct Candidate {
+        std::uint64_t seq;
+        T value;
+    };
+
+    Deque<Candidate> candidates_;
+    std::uint64_t pushed_, popped_;
+    Compare compare_;
+
+public:
+    MonotonicWindow(const Compare &compare = Compare()) :
+            pushed_(0),
+            popped_(0),
+            compare_(compare)
+    {}
+
+    void push(const T &value) {
+        while (!candidates_.empty() && !compare_(candidates_.back().value, value)) {
+            candidates_.pop_back();
+        }
+        candidates_.push_back(Candidate{pushed_++, value});
+    }
+
+    void pop() {
+        if (empty()) {
+            throw std::runtime_error("Window is already empty");
+        }
+        if (candidates_.front().seq == popped_) {
+            candidates_.pop_front();
+        }
+        ++popped_;
+    }
+
+    const T &top() const {
+        return candidates_.front().value;
+    }
+
+    bool empty() const {
+        return pushed_ == popped_;
+    }
+
+    std::size_t size() const {
+        return pushed_ - popped_;
+    }
+};
+
+// FIFO window over an arbitrary monoid (associative, not necessarily
+// commutative) with worst-case O(1) push(), pop() and query().
+//
+// This is the two-stack aggregator with the flip spread over subsequent
+// operations, in the spirit of DABA. Items are stored in one Deque and
+// addressed by absolute position; the window is split into
+//   [front, pending)  front: agg = v[i] * ... * v[pending - 1]
+//   [pending, back)   pending: the previous back, being turned into front
+//   [back, end)       back: only its running aggregate is kept
+// A flip starts when the back outgrows the front. Its BUILD phase computes
+// suffix aggregates of the pending part right to left; its FIX phase then
+// appends the pending aggregate to the surviving front items. Every
+// operation performs STEPS units of that work, which is enough to finish
+// before the front is exhausted.
+template <class T, class Monoid = SumMonoid<T>>
+class SlidingWindowAggregator {
+private:
+    struct Item {
+        T value, agg;
+    };
+
+    enum Phase {
+        IDLE,
+        BUILD,
+        FIX
+    };
+
+    static const int STEPS = 3;
+
+    Deque<Item> items_;
+    Monoid monoid_;
+    T aggPending_, aggBack_;
+    std::uint64_t front_, pending_, back_, end_, cursor_;
+    Phase phase_;
+
+    Item &item(std::uint64_t pos) {
+        return items_[pos - front_];
+    }
+
+    const Item &item(std::uint64_t pos) const {
+        return items_[pos - front_];
+    }
+
+    void start_flip() {
+        pending_ = back_;
+        back_ = end_;
+        aggPending_ = aggBack_;
+        aggBack_ = monoid_.identity();
+        cursor_ = back_;
+        phase_ = BUILD;
+    }
+
+    void step() {
+        if (phase_ == BUILD) {
+            --cursor_;
+            item(cursor_).agg = cursor_ + 1 == back_ ?
+                                item(cursor_).value :
+                                monoid_(item(cursor_).value, item(cursor_ + 1).agg);
+            if (cursor_ == pending_) {
+                phase_ = FIX;
+                cursor_ = pending_;
+            }
+        } else if (phase_ == FIX) {
+            if (cursor_ <= front_) {
+                phase_ = IDLE;
+                pending_ = front_;
+                return;
+            }
+            --cursor_;
+            item(cursor_).agg = monoid_(item(cursor_).agg, aggPending_);
+        }
+    }
+
+    void fixup() {
+        for (int i = 0; i < STEPS; ++i) {
+            if (phase_ == IDLE) {
+                if (end_ - back_ <= back_ - front_) {
+                    return;
+                }
+                start_flip();
+            }
+            step();
+        }
+    }
+
+public:
+    SlidingWindowAggregator(const Monoid &monoid = Monoid()) :
+            monoid_(monoid),
+            aggPending_(monoid_.identity()),
+            aggBack_(monoid_.identity()),
+            front_(0),
+            pending_(0),
+            back_(0),
+            end_(0),
+            cursor_(0),
+            phase_(IDLE)
+    {}
+
+    void push(const T &value) {
+        items_.push_back(Item{value, value});
+        ++end_;
+        aggBack_ = monoid_(aggBack_, value);
+        fixup();
+    }
+
+    void pop() {
+        if (empty()) {
+            throw std::runtime_error("Window is already empty");
+        }
+        // Never taken while the step budget holds; keeps pop() correct anyway.
+        while (phase_ == BUILD && front_ == pending_) {
+            step();
+        }
+        items_.pop_front();
+        ++front_;
+        if (phase_ == FIX && cursor_ < front_) {
+            cursor_ = front_;
+        }
+        fixup();
+    }
+
+    T query() const {
+        if (phase_ == BUILD) {
+            T front = front_ < pending_ ? item(front_).agg : monoid_.identity();
+            return monoid_(monoid_(front, aggPending_), aggBack_);
+        }
+        if (phase_ == FIX && front_ < cursor_) {
+            return monoid_(monoid_(item(front_).agg, aggPending_), aggBack_);
+        }
+        T front = front_ < back_ ? item(front_).agg : monoid_.identity();
+        return monoid_(front, aggBack_);
+    }
+
+    const T &front() const {
+        return items_.front().value;
+    }
+
+    const T &back() const {
+        return items_.back().value;
+    }
+
+    bool empty() const {
+        return items_.empty();
+    }
+
+    std::size_t size() const {
+        return end_ - front_;
+    }
+};
+
+#endif //DEQUE_SLIDINGWINDOW_H
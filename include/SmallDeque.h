@@ -0,0 +1,388 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SMALLDEQUE_H
+#define DEQUE_SMALLDEQUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Deque.h"
+
+// Deque with the first N elements stored inline. Nothing is allocated until
+// the inline ring overflows; then all elements move to a regular Deque. Once
+// that Deque is drained its blocks are released and storage goes back inline.
+template <class T, std::size_t N = 4, class Allocator = std::allocator<T>>
+class SmallDeque {
+    static_assert(N > 0, "SmallDeque needs a non-zero inline capacity");
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef std::size_t size_type;
+private:
+    template <class IterType, class RefType, class PtrType, class DequeType>
+    class SmallDequeIterator : public std::iterator<std::random_access_iterator_tag, IterType> {
+    public:
+        typedef std::ptrdiff_t difference_type;
+    private:
+        difference_type n_;
+        DequeType *deque_;
+        SmallDequeIterator(std::size_t n, DequeType *deque) :
+                n_(n), deque_(deque)
+        {}
+    public:
+        SmallDequeIterator() : n_(0), deque_(nullptr) {}
+
+        bool operator ==(const SmallDequeIterator &other) const {
+            return deque_ == other.deque_ && n_ == other.n_;
+        }
+
+        bool operator !=(const SmallDequeIterator &other) const {
+            return !operator==(other);
+        }
+
+        RefType operator *() const {
+            return deque_->at(n_);
+        }
+
+        PtrType operator ->() const {
+            return &deque_->at(n_);
+        }
+
+        SmallDequeIterator &operator ++() {
+            ++n_;
+            return *this;
+        }
+
+        const SmallDequeIterator operator ++(int) {
+            SmallDequeIterator ans = *this;
+            ++n_;
+            return ans;
+        }
+
+        SmallDequeIterator &operator --() {
+            --n_;
+            return *this;
+        }
+
+        const SmallDequeIterator operator --(int) {
+            SmallDequeIterator ans = *this;
+            --n_;
+            return ans;
+        }
+
+        SmallDequeIterator &operator +=(difference_type diff) {
+            n_ += diff;
+            return *this;
+        }
+
+        SmallDequeIterator &operator -=(difference_type diff) {
+            n_ -= diff;
+            return *this;
+        }
+
+        const SmallDequeIterator operator +(difference_type diff) const {
+            SmallDequeIterator ans = *this;
+            ans += diff;
+            return ans;
+        }
+
+        const SmallDequeIterator operator -(difference_type diff) const {
+            SmallDequeIterator ans = *this;
+            ans -= diff;
+            return ans;
+        }
+
+        difference_type operator -(const SmallDequeIterator &other) const {
+            if (deque_ != other.deque_) {
+                throw std::runtime_error("Container mismatch");
+            }
+            return n_ - other.n_;
+        }
+
+        bool operator <(const SmallDequeIterator &other) const {
+            if (deque_ != other.deque_) {
+                throw std::runtime_error("Container mismatch");
+            }
+            return n_ < other.n_;
+        }
+
+        bool operator >(const SmallDequeIterator &other) const {
+            return other < *this;
+        }
+
+        bool operator <=(const SmallDequeIterator &other) const {
+            return !(other < *this);
+        }
+
+        bool operator >=(const SmallDequeIterator &other) const {
+            return !(*this < other);
+        }
+
+        RefType operator [](difference_type diff) const {
+            return deque_->at(n_ + diff);
+        }
+        friend DequeType;
+    };
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type inline_[N];
+    size_type head_, inlineSize_;
+    Deque<T, Allocator> deque_;
+
+    pointer slot(size_type n) {
+        size_type index = head_ + n;
+        if (index >= N) {
+            index -= N;
+        }
+        return reinterpret_cast<pointer>(&inline_[index]);
+    }
+
+    const_pointer slot(size_type n) const {
+        size_type index = head_ + n;
+        if (index >= N) {
+            index -= N;
+        }
+        return reinterpret_cast<const_pointer>(&inline_[index]);
+    }
+
+    // Transfers the inline elements into a temporary Deque first, so a
+    // throwing allocation or copy leaves the inline ring untouched.
+    void spill() {
+        Deque<T, Allocator> spilled(deque_.get_allocator());
+        for (size_type i = 0; i < inlineSize_; ++i) {
+            spilled.push_back(std::move_if_noexcept(*slot(i)));
+        }
+        deque_.swap(spilled);
+        for (size_type i = 0; i < inlineSize_; ++i) {
+            slot(i)->~T();
+        }
+        head_ = inlineSize_ = 0;
+    }
+
+    void release_if_drained() {
+        if (deque_.empty()) {
+            Deque<T, Allocator>(deque_.get_allocator()).swap(deque_);
+        }
+    }
+
+    void clear() {
+        while (!deque_.empty()) {
+            deque_.pop_back();
+        }
+        for (size_type i = 0; i < inlineSize_; ++i) {
+            slot(i)->~T();
+        }
+        head_ = inlineSize_ = 0;
+    }
+
+    void copy(const SmallDeque &other) {
+        if (other.is_inline()) {
+            for (size_type i = 0; i < other.inlineSize_; ++i) {
+                ::new (static_cast<void *>(slot(i))) T(*other.slot(i));
+                ++inlineSize_;
+            }
+        } else {
+            deque_ = other.deque_;
+        }
+    }
+
+public:
+    typedef SmallDequeIterator<value_type, reference, pointer, SmallDeque<T, N, Allocator>> iterator;
+    typedef SmallDequeIterator<const value_type, const_reference, const_pointer, const SmallDeque<T, N, Allocator>> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    static const std::size_t INLINE_CAPACITY = N;
+
+    SmallDeque(const Allocator &allocator = Allocator()) :
+            head_(0),
+            inlineSize_(0),
+            deque_(allocator)
+    {}
+
+    SmallDeque(const SmallDeque &other) :
+            head_(0),
+            inlineSize_(0),
+            deque_(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
+        copy(other);
+    }
+
+    SmallDeque &operator =(const SmallDeque &other) {
+        if (&other != this) {
+            clear();
+            copy(other);
+        }
+        return *this;
+    }
+
+    ~SmallDeque() {
+        clear();
+    }
+
+    bool is_inline() const {
+        return deque_.empty();
+    }
+
+    void push_back(const value_type &val) {
+        if (is_inline()) {
+            if (inlineSize_ < N) {
+                ::new (static_cast<void *>(slot(inlineSize_))) T(val);
+                ++inlineSize_;
+                return;
+            }
+            // val may be one of the inline elements that spill() moves out.
+            value_type copy(val);
+            spill();
+            deque_.push_back(std::move(copy));
+            return;
+        }
+        deque_.push_back(val);
+    }
+
+    void push_front(const value_type &val) {
+        if (is_inline()) {
+            if (inlineSize_ < N) {
+                size_type head = head_ == 0 ? N - 1 : head_ - 1;
+                ::new (static_cast<void *>(&inline_[head])) T(val);
+                head_ = head;
+                ++inlineSize_;
+                return;
+            }
+            value_type copy(val);
+            spill();
+            deque_.push_front(std::move(copy));
+            return;
+        }
+        deque_.push_front(val);
+    }
+
+    void pop_back() {
+        if (!is_inline()) {
+            deque_.pop_back();
+            release_if_drained();
+            return;
+        }
+        if (inlineSize_ == 0) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        slot(--inlineSize_)->~T();
+    }
+
+    void pop_front() {
+        if (!is_inline()) {
+            deque_.pop_front();
+            release_if_drained();
+            return;
+        }
+        if (inlineSize_ == 0) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        slot(0)->~T();
+        head_ = head_ + 1 == N ? 0 : head_ + 1;
+        --inlineSize_;
+    }
+
+    reference operator [](size_type n) {
+        return at(n);
+    }
+
+    reference at(size_type n) {
+        return is_inline() ? *slot(n) : deque_.at(n);
+    }
+
+    const_reference operator [](size_type n) const {
+        return at(n);
+    }
+
+    const_reference at(size_type n) const {
+        return is_inline() ? *slot(n) : deque_.at(n);
+    }
+
+    reference back() {
+        return is_inline() ? *slot(inlineSize_ - 1) : deque_.back();
+    }
+
+    const_reference back() const {
+        return is_inline() ? *slot(inlineSize_ - 1) : deque_.back();
+    }
+
+    reference front() {
+        return is_inline() ? *slot(0) : deque_.front();
+    }
+
+    const_reference front() const {
+        return is_inline() ? *slot(0) : deque_.front();
+    }
+
+    bool empty() const {
+        return is_inline() && inlineSize_ == 0;
+    }
+
+    size_type size() const {
+        return is_inline() ? inlineSize_ : deque_.size();
+    }
+
+    allocator_type get_allocator() const {
+        return deque_.get_allocator();
+    }
+
+    iterator begin() {
+        return iterator(0, this);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(0, this);
+    }
+
+    const_iterator cbegin() const {
+        return const_iterator(0, this);
+    }
+
+    iterator end() {
+        return iterator(size(), this);
+    }
+
+    const_iterator end() const {
+        return const_iterator(size(), this);
+    }
+
+    const_iterator cend() const {
+        return const_iterator(size(), this);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const {
+        return const_reverse_iterator(begin());
+    }
+};
+
+#endif //DEQUE_SMALLDEQUE_H
@@ -0,0 +1,188 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SOADEQUE_H
+#define DEQUE_SOADEQUE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include "Deque.h"
+
+template <std::size_t... I>
+struct SoaIndices {
+};
+
+template <std::size_t N, std::size_t... I>
+struct MakeSoaIndices : MakeSoaIndices<N - 1, N - 1, I...> {
+};
+
+template <std::size_t... I>
+struct MakeSoaIndices<0, I...> {
+    typedef SoaIndices<I...> type;
+};
+
+// Structure-of-arrays deque: every field is kept in its own Deque column, so
+// a scan over one field reads only that field's blocks and can use the
+// segment-wise algorithms directly. Rows are exposed as tuples of
+// references. The columns do not share a block map: a row access computes
+// the block position once per column, and a push or pop touches one block
+// per column. Columns are only handed out read-only, so they always have
+// the same length.
+template <class... Fields>
+class SoaDeque {
+public:
+    typedef std::tuple<Fields...> value_type;
+    typedef std::tuple<Fields &...> row_reference;
+    typedef std::tuple<const Fields &...> const_row_reference;
+    typedef std::size_t size_type;
+
+    template <std::size_t I>
+    using column_type = Deque<typename std::tuple_element<I, value_type>::type>;
+
+    enum : std::size_t {
+        COLUMNS = sizeof...(Fields)
+    };
+private:
+    typedef typename MakeSoaIndices<sizeof...(Fields)>::type Indices;
+    typedef std::integral_constant<std::size_t, sizeof...(Fields)> End;
+
+    std::tuple<Deque<Fields>...> columns_;
+
+    // Pushes the fields from I on; on failure the columns already pushed are
+    // popped again so that all columns keep the same length.
+    template <std::size_t I>
+    void push_back_from(const const_row_reference &row, std::integral_constant<std::size_t, I>) {
+        std::get<I>(columns_).push_back(std::get<I>(row));
+        try {
+            push_back_from(row, std::integral_constant<std::size_t, I + 1>());
+        } catch (...) {
+            std::get<I>(columns_).pop_back();
+            throw;
+        }
+    }
+
+    void push_back_from(const const_row_reference &, End) {}
+
+    template <std::size_t I>
+    void push_front_from(const const_row_reference &row, std::integral_constant<std::size_t, I>) {
+        std::get<I>(columns_).push_front(std::get<I>(row));
+        try {
+            push_front_from(row, std::integral_constant<std::size_t, I + 1>());
+        } catch (...) {
+            std::get<I>(columns_).pop_front();
+            throw;
+        }
+    }
+
+    void push_front_from(const const_row_reference &, End) {}
+
+    template <std::size_t... I>
+    void pop_front(SoaIndices<I...>) {
+        int expand[] = {0, (std::get<I>(columns_).pop_front(), 0)...};
+        (void) expand;
+    }
+
+    template <std::size_t... I>
+    void pop_back(SoaIndices<I...>) {
+        int expand[] = {0, (std::get<I>(columns_).pop_back(), 0)...};
+        (void) expand;
+    }
+
+    template <std::size_t... I>
+    row_reference row(size_type n, SoaIndices<I...>) {
+        return row_reference(std::get<I>(columns_)[n]...);
+    }
+
+    template <std::size_t... I>
+    const_row_reference row(size_type n, SoaIndices<I...>) const {
+        return const_row_reference(std::get<I>(columns_)[n]...);
+    }
+
+public:
+    void push_back(const Fields &... fields) {
+        push_back_from(const_row_reference(fields...), std::integral_constant<std::size_t, 0>());
+    }
+
+    void push_front(const Fields &... fields) {
+        push_front_from(const_row_reference(fields...), std::integral_constant<std::size_t, 0>());
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        pop_front(Indices());
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("Deque is already empty");
+        }
+        pop_back(Indices());
+    }
+
+    row_reference operator [](size_type n) {
+        return row(n, Indices());
+    }
+
+    const_row_reference operator [](size_type n) const {
+        return row(n, Indices());
+    }
+
+    row_reference front() {
+        return row(0, Indices());
+    }
+
+    const_row_reference front() const {
+        return row(0, Indices());
+    }
+
+    row_reference back() {
+        return row(size() - 1, Indices());
+    }
+
+    const_row_reference back() const {
+        return row(size() - 1, Indices());
+    }
+
+    template <std::size_t I>
+    const column_type<I> &column() const {
+        return std::get<I>(columns_);
+    }
+
+    // The I-th field of row n.
+    template <std::size_t I>
+    typename column_type<I>::reference field(size_type n) {
+        return std::get<I>(columns_)[n];
+    }
+
+    template <std::size_t I>
+    typename column_type<I>::const_reference field(size_type n) const {
+        return std::get<I>(columns_)[n];
+    }
+
+    // Contiguous runs of the I-th field; elements may be modified in place.
+    template <std::size_t I>
+    typename column_type<I>::segment_range column_segments() {
+        return std::get<I>(columns_).segments();
+    }
+
+    template <std::size_t I>
+    typename column_type<I>::const_segment_range column_segments() const {
+        return std::get<I>(columns_).segments();
+    }
+
+    bool empty() const {
+        return std::get<0>(columns_).empty();
+    }
+
+    size_type size() const {
+        return std::get<0>(columns_).size();
+    }
+};
+
+#endif //DEQUE_SOADEQUE_H
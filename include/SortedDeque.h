@@ -0,0 +1,166 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_SORTEDDEQUE_H
+#define DEQUE_SORTEDDEQUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.h"
+#include "GrowableRingBuffer.h"
+
+template <class T>
+struct IdentityKey {
+    const T &operator ()(const T &value) const {
+        return value;
+    }
+};
+
+// Deque whose elements are kept in non-decreasing key order, e.g. events
+// keyed by timestamp. Next to the elements it keeps the key of the first
+// element of every block in a dense ring, so a search is a binary search over
+// that small array followed by one within a single block.
+template <class T, class KeyFn = IdentityKey<T>>
+class SortedDeque {
+public:
+    typedef T value_type;
+    typedef typename std::decay<decltype(std::declval<KeyFn>()(std::declval<const T &>()))>::type key_type;
+    typedef typename Deque<T>::const_iterator const_iterator;
+    typedef typename Deque<T>::size_type size_type;
+private:
+    Deque<T> deque_;
+    GrowableRingBuffer<key_type> firstKeys_;
+    KeyFn key_;
+
+    // Index of the first element whose key is not less (with Upper, greater)
+    // than the given one.
+    template <bool Upper>
+    size_type bound(const key_type &key) const {
+        auto block = Upper ? std::upper_bound(firstKeys_.begin(), firstKeys_.end(), key) :
+                             std::lower_bound(firstKeys_.begin(), firstKeys_.end(), key);
+        size_type i = block - firstKeys_.begin();
+        if (i == 0) {
+            return 0;
+        }
+        --i;
+        auto segment = deque_.block_segment(i);
+        const KeyFn &keyFn = key_;
+        auto it = Upper ?
+                  std::upper_bound(segment.begin(), segment.end(), key, [&keyFn](const key_type &k, const T &value) {
+                      return k < keyFn(value);
+                  }) :
+                  std::lower_bound(segment.begin(), segment.end(), key, [&keyFn](const T &value, const key_type &k) {
+                      return keyFn(value) < k;
+                  });
+        return deque_.block_first_index(i) + (it - segment.begin());
+    }
+
+    void sync_front(size_type blocksBefore) {
+        for (size_type i = deque_.getBlocksCount(); i < blocksBefore; ++i) {
+            firstKeys_.pop_front();
+        }
+        if (!deque_.empty()) {
+            firstKeys_.front() = key_(deque_.front());
+        }
+    }
+
+public:
+    SortedDeque(const KeyFn &key = KeyFn()) : key_(key) {}
+
+    void push_back(const T &value) {
+        if (!deque_.empty() && key_(value) < key_(deque_.back())) {
+            throw std::runtime_error("Key is less than the last one");
+        }
+        size_type blocks = deque_.getBlocksCount();
+        deque_.push_back(value);
+        if (deque_.getBlocksCount() != blocks) {
+            firstKeys_.push_back(key_(value));
+        }
+    }
+
+    void pop_front() {
+        size_type blocks = deque_.getBlocksCount();
+        deque_.pop_front();
+        sync_front(blocks);
+    }
+
+    void pop_back() {
+        size_type blocks = deque_.getBlocksCount();
+        deque_.pop_back();
+        if (deque_.getBlocksCount() != blocks) {
+            firstKeys_.pop_back();
+        }
+    }
+
+    // Removes the leading elements satisfying pred, which must hold for a
+    // prefix of the deque (e.g. "older than a cutoff"). Blocks are checked by
+    // their last element and released whole. Returns the number removed.
+    template <class Predicate>
+    size_type expire_front_while(Predicate pred) {
+        size_type count = 0;
+        for (size_type i = 0; i < deque_.getBlocksCount(); ++i) {
+            auto segment = deque_.block_segment(i);
+            if (pred(*(segment.end() - 1))) {
+                count += segment.size();
+            } else {
+                count += std::partition_point(segment.begin(), segment.end(), pred) - segment.begin();
+                break;
+            }
+        }
+        size_type blocks = deque_.getBlocksCount();
+        deque_.pop_front_n(count);
+        sync_front(blocks);
+        return count;
+    }
+
+    const_iterator lower_bound(const key_type &key) const {
+        return deque_.begin() + bound<false>(key);
+    }
+
+    const_iterator upper_bound(const key_type &key) const {
+        return deque_.begin() + bound<true>(key);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    const T &operator [](size_type n) const {
+        return deque_[n];
+    }
+
+    const T &front() const {
+        return deque_.front();
+    }
+
+    const T &back() const {
+        return deque_.back();
+    }
+
+    bool empty() const {
+        return deque_.empty();
+    }
+
+    size_type size() const {
+        return deque_.size();
+    }
+
+    const_iterator begin() const {
+        return deque_.begin();
+    }
+
+    const_iterator end() const {
+        return deque_.end();
+    }
+
+    const Deque<T> &data() const {
+        return deque_;
+    }
+};
+
+#endif //DEQUE_SORTEDDEQUE_H
@@ -0,0 +1,214 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_STATICRINGBUFFER_H
+#define DEQUE_STATICRINGBUFFER_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Storage for StaticRingBuffer. Split out so that the buffer keeps a trivial
+// destructor (and thus stays a literal type) when T has one. The whole array
+// sits in one union whose constexpr constructor only sets a dummy byte, so
+// construction does not touch the N slots.
+template <class T, std::size_t N, bool = std::is_trivially_destructible<T>::value>
+class StaticRingBufferBase {
+protected:
+    union Storage {
+        char none;
+        T values[N];
+        constexpr Storage() noexcept : none() {}
+    };
+
+    Storage storage_;
+    std::size_t head_, tail_;
+
+    constexpr StaticRingBufferBase() noexcept : storage_(), head_(0), tail_(0) {}
+
+    void destroy_all() noexcept {}
+};
+
+template <class T, std::size_t N>
+class StaticRingBufferBase<T, N, false> {
+protected:
+    union Storage {
+        char none;
+        T values[N];
+        constexpr Storage() noexcept : none() {}
+        ~Storage() {}
+    };
+
+    Storage storage_;
+    std::size_t head_, tail_;
+
+    constexpr StaticRingBufferBase() noexcept : storage_(), head_(0), tail_(0) {}
+
+    ~StaticRingBufferBase() {
+        destroy_all();
+    }
+
+    void destroy_all() noexcept {
+        for (std::size_t pos = head_; pos != tail_; ++pos) {
+            storage_.values[pos & (N - 1)].~T();
+        }
+    }
+};
+
+// Fixed-capacity ring buffer with inline storage. N is a power of two, so
+// wrapping is a mask with a compile-time constant; nothing is allocated.
+// Like RingBuffer, pushes into a full buffer and pops from an empty one are
+// ignored; push_* report whether the value was stored. Only construction,
+// capacity(), size(), empty() and full() are constexpr: C++11 constexpr
+// functions cannot modify the buffer.
+template <class T, std::size_t N>
+class StaticRingBuffer : private StaticRingBufferBase<T, N> {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "StaticRingBuffer capacity must be a power of two");
+private:
+    typedef StaticRingBufferBase<T, N> Base;
+    using Base::storage_;
+    using Base::head_;
+    using Base::tail_;
+
+    static constexpr std::size_t MASK = N - 1;
+
+    T *slot(std::size_t pos) noexcept {
+        return &storage_.values[pos & MASK];
+    }
+
+    const T *slot(std::size_t pos) const noexcept {
+        return &storage_.values[pos & MASK];
+    }
+
+    void copy(const StaticRingBuffer &other) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        for (std::size_t pos = other.head_; pos != other.tail_; ++pos) {
+            ::new (static_cast<void *>(slot(tail_))) T(*other.slot(pos));
+            ++tail_;
+        }
+    }
+
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+
+    constexpr StaticRingBuffer() noexcept {}
+
+    StaticRingBuffer(const StaticRingBuffer &other) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        copy(other);
+    }
+
+    StaticRingBuffer &operator =(const StaticRingBuffer &other)
+            noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        if (&other != this) {
+            clear();
+            copy(other);
+        }
+        return *this;
+    }
+
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return tail_ - head_;
+    }
+
+    constexpr bool empty() const noexcept {
+        return head_ == tail_;
+    }
+
+    constexpr bool full() const noexcept {
+        return tail_ - head_ == N;
+    }
+
+    void clear() noexcept {
+        Base::destroy_all();
+        head_ = tail_ = 0;
+    }
+
+    bool push_back(const T &val) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        if (full()) {
+            return false;
+        }
+        ::new (static_cast<void *>(slot(tail_))) T(val);
+        ++tail_;
+        return true;
+    }
+
+    bool push_back(T &&val) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (full()) {
+            return false;
+        }
+        ::new (static_cast<void *>(slot(tail_))) T(std::move(val));
+        ++tail_;
+        return true;
+    }
+
+    bool push_front(const T &val) noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        if (full()) {
+            return false;
+        }
+        ::new (static_cast<void *>(slot(head_ - 1))) T(val);
+        --head_;
+        return true;
+    }
+
+    bool push_front(T &&val) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (full()) {
+            return false;
+        }
+        ::new (static_cast<void *>(slot(head_ - 1))) T(std::move(val));
+        --head_;
+        return true;
+    }
+
+    void pop_back() noexcept {
+        if (empty()) {
+            return;
+        }
+        --tail_;
+        slot(tail_)->~T();
+    }
+
+    void pop_front() noexcept {
+        if (empty()) {
+            return;
+        }
+        slot(head_)->~T();
+        ++head_;
+    }
+
+    T &operator [](std::size_t n) noexcept {
+        return *slot(head_ + n);
+    }
+
+    const T &operator [](std::size_t n) const noexcept {
+        return *slot(head_ + n);
+    }
+
+    T &front() noexcept {
+        return *slot(head_);
+    }
+
+    const T &front() const noexcept {
+        return *slot(head_);
+    }
+
+    T &back() noexcept {
+        return *slot(tail_ - 1);
+    }
+
+    const T &back() const noexcept {
+        return *slot(tail_ - 1);
+    }
+};
+
+template <class T, std::size_t N>
+constexpr std::size_t StaticRingBuffer<T, N>::MASK;
+
+#endif //DEQUE_STATICRINGBUFFER_H
@@ -0,0 +1,212 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_TIMINGWHEEL_H
+#define DEQUE_TIMINGWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Deque.h"
+#include "RingBuffer.h"
+
+// Hierarchical timing wheel over integer ticks. Level l has 2^SlotBits slots
+// of 2^(l * SlotBits) ticks each, kept in a RingBuffer of slot pointers
+// rotated so that its front is always the current slot; a slot is a Deque of
+// timer references. When a level's front moves on, the slot that becomes
+// current is cascaded into the levels below. Timers beyond the top level are
+// parked in its last slot and re-placed when it is reached.
+//
+// Timers themselves live in a table indexed by handle. cancel() only bumps
+// the generation of the table entry, which turns the reference left in the
+// slot into a tombstone, so schedule(), cancel() and each tick are O(1).
+template <class T, std::size_t Levels = 4, std::size_t SlotBits = 8>
+class TimingWheel {
+    static_assert(Levels > 0 && SlotBits > 0 && Levels * SlotBits < 64, "Unsupported TimingWheel geometry");
+public:
+    typedef T value_type;
+    typedef std::uint64_t tick_type;
+    typedef std::size_t size_type;
+
+    enum : std::size_t {
+        SLOTS = std::size_t(1) << SlotBits
+    };
+
+    class Handle {
+    private:
+        std::uint32_t index_, generation_;
+        Handle(std::uint32_t index, std::uint32_t generation) : index_(index), generation_(generation) {}
+    public:
+        Handle() : index_(~std::uint32_t(0)), generation_(0) {}
+
+        friend class TimingWheel;
+    };
+private:
+    struct Timer {
+        tick_type expiry;
+        std::uint32_t generation;
+        T value;
+    };
+
+    struct Ref {
+        std::uint32_t index, generation;
+    };
+
+    typedef Deque<Ref> Slot;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::vector<RingBuffer<Slot *>> levels_;
+    Deque<Timer> timers_;
+    Deque<std::uint32_t> free_;
+    std::vector<T> expired_;
+    tick_type now_;
+    size_type size_;
+
+    bool live(const Ref &ref) const {
+        return timers_[ref.index].generation == ref.generation;
+    }
+
+    void release(std::uint32_t index) {
+        ++timers_[index].generation;
+        free_.push_back(index);
+        --size_;
+    }
+
+    void place(const Ref &ref) {
+        tick_type expiry = timers_[ref.index].expiry;
+        for (std::size_t level = 0; level < Levels; ++level) {
+            std::size_t shift = level * SlotBits;
+            tick_type distance = (expiry >> shift) - (now_ >> shift);
+            if (distance < SLOTS) {
+                levels_[level][distance]->push_back(ref);
+                return;
+            }
+        }
+        levels_[Levels - 1][SLOTS - 1]->push_back(ref);
+    }
+
+    static void rotate(RingBuffer<Slot *> &ring) {
+        Slot *slot = ring.front();
+        ring.pop_front();
+        ring.push_back(slot);
+    }
+
+    void tick() {
+        Slot &due = *levels_[0].front();
+        for (const Ref &ref : due) {
+            if (live(ref)) {
+                expired_.push_back(timers_[ref.index].value);
+                release(ref.index);
+            }
+        }
+        due.pop_front_n(due.size());
+        rotate(levels_[0]);
+        ++now_;
+
+        std::size_t rotated = 1;
+        while (rotated < Levels && (now_ & ((tick_type(1) << (rotated * SlotBits)) - 1)) == 0) {
+            rotate(levels_[rotated++]);
+        }
+        for (std::size_t level = rotated - 1; level > 0; --level) {
+            Slot &current = *levels_[level].front();
+            for (const Ref &ref : current) {
+                if (live(ref)) {
+                    place(ref);
+                }
+            }
+            current.pop_front_n(current.size());
+        }
+    }
+
+public:
+    explicit TimingWheel(tick_type now = 0) : slots_(new Slot[Levels * SLOTS]), now_(now), size_(0) {
+        levels_.reserve(Levels);
+        for (std::size_t level = 0; level < Levels; ++level) {
+            levels_.emplace_back(SLOTS);
+            for (std::size_t i = 0; i < SLOTS; ++i) {
+                levels_[level].push_back(&slots_[level * SLOTS + i]);
+            }
+        }
+    }
+
+    TimingWheel(const TimingWheel &) = delete;
+    TimingWheel &operator =(const TimingWheel &) = delete;
+
+    // Schedules value to expire at tick expiry; ticks before now() count as
+    // now().
+    Handle schedule(tick_type expiry, const T &value) {
+        if (expiry < now_) {
+            expiry = now_;
+        }
+        std::uint32_t index;
+        if (free_.empty()) {
+            index = static_cast<std::uint32_t>(timers_.size());
+            timers_.push_back(Timer{expiry, 0, value});
+        } else {
+            index = free_.back();
+            free_.pop_back();
+            timers_[index].expiry = expiry;
+            timers_[index].value = value;
+        }
+        Ref ref{index, timers_[index].generation};
+        place(ref);
+        ++size_;
+        return Handle(index, ref.generation);
+    }
+
+    // Returns false if the timer has already expired or been cancelled.
+    bool cancel(const Handle &handle) {
+        if (!pending(handle)) {
+            return false;
+        }
+        release(handle.index_);
+        return true;
+    }
+
+    bool pending(const Handle &handle) const {
+        return handle.index_ < timers_.size() && timers_[handle.index_].generation == handle.generation_;
+    }
+
+    tick_type expiry(const Handle &handle) const {
+        return timers_[handle.index_].expiry;
+    }
+
+    // Expires every timer due at or before now and passes their values to
+    // onExpired(const T *values, size_type n) in one batch, in expiry order.
+    // Returns the number of expired timers.
+    template <class Callback>
+    size_type advance(tick_type now, Callback onExpired) {
+        while (now_ <= now) {
+            if (size_ == 0) {
+                // Only tombstones are left, so the slots need not line up.
+                now_ = now + 1;
+                break;
+            }
+            tick();
+        }
+        size_type count = expired_.size();
+        if (count != 0) {
+            onExpired(static_cast<const T *>(expired_.data()), count);
+            expired_.clear();
+        }
+        return count;
+    }
+
+    // The first tick not processed yet.
+    tick_type now() const {
+        return now_;
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+};
+
+#endif //DEQUE_TIMINGWHEEL_H
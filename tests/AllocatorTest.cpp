@@ -0,0 +1,195 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Deque.h>
+#include <MemoryResource.h>
+#include <deque>
+#include <algorithm>
+#include <iostream>
+#include "Measure.h"
+
+class CountingResource : public MemoryResource {
+public:
+    std::size_t allocations = 0, deallocations = 0, bytes = 0;
+protected:
+    void *do_allocate(std::size_t size, std::size_t) override {
+        ++allocations;
+        bytes += size;
+        return ::operator new(size);
+    }
+
+    void do_deallocate(void *ptr, std::size_t size, std::size_t) override {
+        ++deallocations;
+        bytes -= size;
+        ::operator delete(ptr);
+    }
+};
+
+template <class T, bool Propagate>
+class TaggedAllocator {
+public:
+    typedef T value_type;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+
+    int tag;
+
+    TaggedAllocator(int tag = 0) : tag(tag) {}
+
+    template <class U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate> &other) : tag(other.tag) {}
+
+    T *allocate(std::size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *ptr, std::size_t n) {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <class U>
+    struct rebind {
+        typedef TaggedAllocator<U, Propagate> other;
+    };
+};
+
+template <class T, class U, bool P>
+bool operator ==(const TaggedAllocator<T, P> &, const TaggedAllocator<U, P> &) {
+    return true;
+}
+
+template <class T, class U, bool P>
+bool operator !=(const TaggedAllocator<T, P> &a, const TaggedAllocator<U, P> &b) {
+    return !(a == b);
+}
+
+TEST(AllocatorTest, EveryAllocationGoesThroughAllocator) {
+    CountingResource resource;
+    {
+        Deque<int, PolymorphicAllocator<int>> d(&resource);
+        for (int i = 0; i < 10000; ++i) {
+            d.push_back(i);
+            d.push_front(-i);
+        }
+        // Element buffers, DataBlock headers and block maps.
+        ASSERT_GT(resource.allocations, 2 * d.getBlocksCount());
+
+        Deque<int, PolymorphicAllocator<int>> moved(std::move(d));
+        ASSERT_TRUE(d.empty());
+        ASSERT_EQ(moved.size(), 20000);
+        ASSERT_EQ(moved.get_allocator().resource(), &resource);
+
+        while (!moved.empty()) {
+            moved.pop_back();
+        }
+    }
+    ASSERT_EQ(resource.allocations, resource.deallocations);
+    ASSERT_EQ(resource.bytes, 0);
+}
+
+TEST(AllocatorTest, CopyConstructionSelectsAllocator) {
+    CountingResource resource;
+    Deque<int, PolymorphicAllocator<int>> d(&resource);
+    for (int i = 0; i < 1000; ++i) {
+        d.push_back(i);
+    }
+    Deque<int, PolymorphicAllocator<int>> copy(d);
+    ASSERT_EQ(copy.get_allocator().resource(), new_delete_resource());
+    ASSERT_TRUE(std::equal(d.begin(), d.end(), copy.begin()));
+
+    Deque<int, TaggedAllocator<int, true>> tagged(TaggedAllocator<int, true>(7));
+    tagged.push_back(1);
+    Deque<int, TaggedAllocator<int, true>> taggedCopy(tagged);
+    ASSERT_EQ(taggedCopy.get_allocator().tag, 7);
+}
+
+TEST(AllocatorTest, PropagateOnAssignment) {
+    Deque<int, TaggedAllocator<int, true>> a(TaggedAllocator<int, true>(1)), b(TaggedAllocator<int, true>(2));
+    for (int i = 0; i < 500; ++i) {
+        a.push_back(i);
+    }
+    b = a;
+    ASSERT_EQ(b.get_allocator().tag, 1);
+    ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+
+    Deque<int, TaggedAllocator<int, true>> c(TaggedAllocator<int, true>(3));
+    c = std::move(a);
+    ASSERT_EQ(c.get_allocator().tag, 1);
+    ASSERT_EQ(c.size(), 500);
+
+    Deque<int, TaggedAllocator<int, true>> e(TaggedAllocator<int, true>(4));
+    e.swap(c);
+    ASSERT_EQ(e.get_allocator().tag, 1);
+    ASSERT_EQ(c.get_allocator().tag, 4);
+    ASSERT_EQ(e.size(), 500);
+    ASSERT_TRUE(c.empty());
+
+    Deque<int, TaggedAllocator<int, false>> x(TaggedAllocator<int, false>(1)), y(TaggedAllocator<int, false>(2));
+    x.push_back(42);
+    y = x;
+    ASSERT_EQ(y.get_allocator().tag, 2);
+    ASSERT_EQ(y.front(), 42);
+    y = std::move(x);
+    ASSERT_EQ(y.get_allocator().tag, 2);
+    ASSERT_EQ(y.size(), 1);
+}
+
+TEST(AllocatorTest, ArenaDeque) {
+    MonotonicArena arena;
+    {
+        Deque<std::string, PolymorphicAllocator<std::string>> d(&arena);
+        for (int i = 0; i < 1000; ++i) {
+            d.push_back(std::to_string(i));
+        }
+        ASSERT_EQ(d[999], "999");
+        ASSERT_GT(arena.bytes_allocated(), 1000 * sizeof(std::string));
+    }
+    arena.release();
+    ASSERT_EQ(arena.bytes_allocated(), 0);
+}
+
+class ArenaTimeTest : public testing::TestWithParam<std::size_t> {
+};
+
+TEST_P(ArenaTimeTest, TimeMeasurement) {
+    std::size_t n = GetParam();
+
+    MEASURE_TIME_BEGIN(defaultMs);
+    {
+        Deque<int> d;
+        for (std::size_t i = 0; i < n; ++i) {
+            d.push_back(i);
+            d.push_front(i);
+        }
+        while (!d.empty()) {
+            d.pop_back();
+        }
+    }
+    MEASURE_TIME_END(defaultMs);
+
+    MEASURE_TIME_BEGIN(arenaMs);
+    {
+        MonotonicArena arena;
+        Deque<int, PolymorphicAllocator<int>> d(&arena);
+        for (std::size_t i = 0; i < n; ++i) {
+            d.push_back(i);
+            d.push_front(i);
+        }
+        while (!d.empty()) {
+            d.pop_back();
+        }
+    }
+    MEASURE_TIME_END(arenaMs);
+
+    std::cout   << "std::allocator time: " << defaultMs << " ms." << std::endl
+                << "MonotonicArena time: " << arenaMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(defaultMs, "std::allocator", 4.0 * n);
+    MEASURE_PERF_REPORT(arenaMs, "MonotonicArena", 4.0 * n);
+}
+
+INSTANTIATE_TEST_CASE_P(ArenaTimeTest,
+                        ArenaTimeTest,
+                        testing::Values(1000, 100000, 1000000, 10000000));
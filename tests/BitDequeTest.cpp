@@ -0,0 +1,105 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <BitDeque.h>
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <random>
+#include "Measure.h"
+
+TEST(BitDequeTest, MatchesStdDeque) {
+    BitDeque bits;
+    std::deque<bool> expected;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 50000; ++i) {
+        unsigned op = gen() % 10;
+        if (expected.empty() || op < 3) {
+            bool value = gen() % 3 == 0;
+            bits.push_back(value);
+            expected.push_back(value);
+        } else if (op < 6) {
+            bool value = gen() % 3 == 0;
+            bits.push_front(value);
+            expected.push_front(value);
+        } else if (op < 8) {
+            bits.pop_front();
+            expected.pop_front();
+        } else {
+            bits.pop_back();
+            expected.pop_back();
+        }
+        ASSERT_EQ(bits.size(), expected.size());
+        if (!expected.empty()) {
+            ASSERT_EQ(bits.front(), expected.front());
+            ASSERT_EQ(bits.back(), expected.back());
+            std::size_t n = gen() % expected.size();
+            ASSERT_EQ(bits[n], expected[n]);
+        }
+        if (i % 97 == 0) {
+            ASSERT_EQ(bits.count(), static_cast<std::size_t>(std::count(expected.begin(), expected.end(), true)));
+            std::size_t from = expected.empty() ? 0 : gen() % expected.size();
+            ASSERT_EQ(bits.find_first(from),
+                      static_cast<std::size_t>(std::find(expected.begin() + from, expected.end(), true) -
+                                               expected.begin()));
+        }
+    }
+}
+
+TEST(BitDequeTest, ProxyReference) {
+    BitDeque bits;
+    for (int i = 0; i < 200; ++i) {
+        bits.push_front(false);
+    }
+    ASSERT_EQ(bits.find_first(), 200);
+    bits[130] = true;
+    bits[7] = bits[130];
+    bits.back() = true;
+    bits[150].flip();
+    ASSERT_EQ(bits.count(), 4);
+    ASSERT_EQ(bits.find_first(), 7);
+    ASSERT_EQ(bits.find_first(8), 130);
+    ASSERT_EQ(bits.find_first(131), 150);
+    ASSERT_EQ(bits.find_first(151), 199);
+    const BitDeque &constBits = bits;
+    ASSERT_TRUE(constBits[130]);
+    ASSERT_FALSE(constBits[131]);
+    ASSERT_EQ(bits.words().size(), 4);
+    while (!bits.empty()) {
+        bits.pop_back();
+    }
+    ASSERT_EQ(bits.words().size(), 0);
+    ASSERT_THROW(bits.pop_front(), std::runtime_error);
+}
+
+TEST(BitDequeTimeTest, TimeMeasurement) {
+    const std::size_t n = 100000000;
+    Deque<bool> bytes;
+    BitDeque bits;
+    for (std::size_t i = 0; i < n; ++i) {
+        bool value = i % 3 == 0;
+        bytes.push_back(value);
+        bits.push_back(value);
+    }
+
+    MEASURE_TIME_BEGIN(bytesMs);
+    std::size_t bytesCount = 0;
+    for (auto segment : bytes.segments()) {
+        bytesCount += std::count(segment.begin(), segment.end(), true);
+    }
+    MEASURE_TIME_END(bytesMs);
+
+    MEASURE_TIME_BEGIN(bitsMs);
+    std::size_t bitsCount = bits.count();
+    MEASURE_TIME_END(bitsMs);
+
+    ASSERT_EQ(bytesCount, bitsCount);
+    std::cout   << "Deque<bool> blocks: " << bytes.getBlocksCount()
+                << ", BitDeque blocks: " << bits.words().getBlocksCount() << std::endl
+                << "Deque<bool> count time: " << bytesMs << " ms." << std::endl
+                << "BitDeque count time: " << bitsMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(bytesMs, "Deque<bool> count", n);
+    MEASURE_PERF_REPORT(bitsMs, "BitDeque count", n);
+}
@@ -0,0 +1,139 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <ByteBuffer.h>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+std::string contents(const ByteBuffer &buffer) {
+    std::string ans(buffer.size(), '\0');
+    buffer.peek(&ans[0], ans.size());
+    return ans;
+}
+
+std::string pattern(std::size_t n) {
+    std::string ans(n, '\0');
+    for (std::size_t i = 0; i < n; ++i) {
+        ans[i] = static_cast<char>('a' + i * 7 % 26);
+    }
+    return ans;
+}
+
+}
+
+TEST(ByteBufferTest, GrowBackPopBackN) {
+    Deque<int> deque;
+    std::deque<int> expected;
+    std::mt19937 gen(8);
+    for (int round = 0; round < 300; ++round) {
+        std::size_t grow = gen() % 1000;
+        deque.grow_back(grow);
+        for (std::size_t i = 0; i < grow; ++i) {
+            deque[deque.size() - grow + i] = round;
+            expected.push_back(round);
+        }
+        deque.push_front(-round);
+        expected.push_front(-round);
+        std::size_t shrink = gen() % (expected.size() + 1);
+        deque.pop_back_n(shrink);
+        expected.erase(expected.end() - shrink, expected.end());
+        ASSERT_EQ(deque.size(), expected.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), deque.begin()));
+    }
+    ASSERT_THROW(deque.pop_back_n(deque.size() + 1), std::runtime_error);
+    deque.pop_back_n(deque.size());
+    ASSERT_EQ(deque.back_capacity(), 0);
+    deque.push_back(1);
+    ASSERT_EQ(deque.back_capacity(), Deque<int>::block_size() - 1);
+
+    Deque<std::string> strings;
+    strings.grow_back(1000);
+    ASSERT_EQ(strings.size(), 1000);
+    ASSERT_TRUE(strings[999].empty());
+}
+
+TEST(ByteBufferTest, AppendPeekFind) {
+    ByteBuffer buffer;
+    std::string text = pattern(5000);
+    text.replace(1020, 4, "\r\n\r\n");
+    text.replace(3000, 4, "\r\n\r\n");
+    buffer.append(text.data(), text.size());
+    ASSERT_EQ(contents(buffer), text);
+    ASSERT_EQ(buffer.find("\r\n\r\n", 4), 1020);
+    ASSERT_EQ(buffer.find("\r\n\r\n", 4, 1021), 3000);
+    ASSERT_EQ(buffer.find("\r\n\r\n", 4, 3001), ByteBuffer::NPOS);
+    ASSERT_EQ(buffer.find('\n'), 1021);
+
+    buffer.drain(1000);
+    ASSERT_EQ(buffer.find("\r\n\r\n", 4), 20);
+    ASSERT_EQ(contents(buffer), text.substr(1000));
+
+    auto range = buffer.reserve(3000);
+    ASSERT_THROW(buffer.append("x", 1), std::runtime_error);
+    std::size_t filled = 0;
+    for (auto segment : range) {
+        std::memset(segment.data(), 'z', segment.size());
+        filled += segment.size();
+    }
+    ASSERT_EQ(filled, 3000);
+    buffer.commit(10);
+    ASSERT_EQ(contents(buffer), text.substr(1000) + std::string(10, 'z'));
+    ASSERT_THROW(buffer.commit(1), std::runtime_error);
+}
+
+TEST(ByteBufferTest, Pipe) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string text = pattern(40000);
+    ByteBuffer out, in;
+    out.append(text.data(), text.size());
+    ASSERT_EQ(out.write_to_fd(fds[1]), 40000);
+    ASSERT_TRUE(out.empty());
+    ASSERT_EQ(in.read_from_fd(fds[0], 0), 0);
+    ASSERT_TRUE(in.empty());
+    close(fds[1]);
+    ssize_t n;
+    while ((n = in.read_from_fd(fds[0], 3000)) > 0) {
+        ASSERT_LE(n, 3000);
+    }
+    ASSERT_EQ(n, 0);
+    close(fds[0]);
+    ASSERT_EQ(contents(in), text);
+}
+
+TEST(ByteBufferTest, NonBlockingSocketPair) {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    std::string text = pattern(1 << 20);
+    ByteBuffer out, in;
+    out.append(text.data(), text.size());
+    while (in.size() < text.size()) {
+        if (out.write_to_fd(fds[0]) < 0) {
+            ASSERT_EQ(errno, EAGAIN);
+        }
+        ssize_t n = in.read_from_fd(fds[1]);
+        if (n < 0) {
+            ASSERT_EQ(errno, EAGAIN);
+        } else {
+            ASSERT_LE(n, (ByteBuffer::READ_BLOCKS + 1) * Deque<char>::block_size());
+        }
+    }
+    ASSERT_TRUE(out.empty());
+    ASSERT_EQ(in.read_from_fd(fds[1]), -1);
+    ASSERT_EQ(errno, EAGAIN);
+    close(fds[0]);
+    close(fds[1]);
+    ASSERT_EQ(contents(in), text);
+}
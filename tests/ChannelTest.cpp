@@ -0,0 +1,301 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Channel.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+Task produce(Channel<int> &channel, int from, int to, bool close) {
+    for (int i = from; i < to; ++i) {
+        co_await channel.push(i);
+    }
+    if (close) {
+        channel.close();
+    }
+}
+
+Task consume(Channel<int> &channel, std::vector<int> &out) {
+    while (auto value = co_await channel.pop()) {
+        out.push_back(*value);
+    }
+}
+
+Task consume_batches(Channel<int> &channel, std::vector<int> &out, std::size_t &batches) {
+    while (true) {
+        std::vector<int> batch = co_await channel.pop_batch(64);
+        if (batch.empty()) {
+            break;
+        }
+        ++batches;
+        out.insert(out.end(), batch.begin(), batch.end());
+    }
+}
+
+// Stage of a pipeline: adds one to every value.
+Task increment(Channel<std::uint64_t> &in, Channel<std::uint64_t> &out) {
+    while (auto value = co_await in.pop()) {
+        co_await out.push(*value + 1);
+    }
+    out.close();
+}
+
+Task feed(Channel<std::uint64_t> &out, std::uint64_t n) {
+    for (std::uint64_t i = 0; i < n; ++i) {
+        co_await out.push(i);
+    }
+    out.close();
+}
+
+Task sum_up(Channel<std::uint64_t> &in, std::uint64_t &sum) {
+    while (true) {
+        auto batch = co_await in.pop_batch(256);
+        if (batch.empty()) {
+            break;
+        }
+        for (auto value : batch) {
+            sum += value;
+        }
+    }
+}
+
+// Mutex and condition variable queue for the thread-per-stage baseline.
+template <class T>
+class BlockingQueue {
+private:
+    std::mutex mutex_;
+    std::condition_variable notEmpty_, notFull_;
+    Deque<T> queue_;
+    std::size_t capacity_;
+    bool closed_ = false;
+public:
+    explicit BlockingQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    void push(const T &value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this]() {
+            return queue_.size() < capacity_;
+        });
+        queue_.push_back(value);
+        notEmpty_.notify_one();
+    }
+
+    bool pop(T &out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this]() {
+            return closed_ || !queue_.empty();
+        });
+        if (queue_.empty()) {
+            return false;
+        }
+        out = queue_.front();
+        queue_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+    }
+};
+
+}
+
+TEST(ChannelTest, SingleThread) {
+    SingleThreadExecutor executor;
+    Channel<int> channel(executor, 16);
+    std::vector<int> out;
+    executor.spawn(consume(channel, out));
+    executor.spawn(produce(channel, 0, 10000, true));
+    ASSERT_EQ(executor.run(), 0);
+    ASSERT_EQ(out.size(), 10000);
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(out[i], i);
+    }
+    ASSERT_THROW(Channel<int>(executor, 0), std::runtime_error);
+}
+
+TEST(ChannelTest, Batches) {
+    SingleThreadExecutor executor;
+    Channel<int> channel(executor, 1000);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_TRUE(channel.try_push(i));
+    }
+    std::vector<int> out;
+    std::size_t batches = 0;
+    executor.spawn(consume_batches(channel, out, batches));
+    executor.spawn(produce(channel, 500, 1000, true));
+    ASSERT_EQ(executor.run(), 0);
+    ASSERT_EQ(out.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(out[i], i);
+    }
+    ASSERT_LT(batches, 100);
+}
+
+TEST(ChannelTest, Close) {
+    SingleThreadExecutor executor;
+    Channel<int> full(executor, 1), empty(executor);
+    ASSERT_TRUE(full.try_push(1));
+    ASSERT_FALSE(full.try_push(2));
+
+    int pushed = -1;
+    std::optional<int> popped = 5;
+    auto blocked_push = [&]() -> Task {
+        pushed = co_await full.push(3);
+    };
+    auto blocked_pop = [&]() -> Task {
+        popped = co_await empty.pop();
+    };
+    executor.spawn(blocked_push());
+    executor.spawn(blocked_pop());
+    ASSERT_EQ(executor.run(), 2);
+    full.close();
+    empty.close();
+    ASSERT_EQ(executor.run(), 0);
+    ASSERT_EQ(pushed, 0);
+    ASSERT_FALSE(popped.has_value());
+
+    // Buffered values survive close.
+    ASSERT_EQ(full.try_pop(), std::optional<int>(1));
+    ASSERT_FALSE(full.try_pop().has_value());
+    ASSERT_FALSE(full.try_push(4));
+}
+
+TEST(ChannelTest, SuspendedFramesAreDestroyed) {
+    static int alive = 0;
+    struct Guard {
+        Guard() {
+            ++alive;
+        }
+
+        ~Guard() {
+            --alive;
+        }
+    };
+    {
+        SingleThreadExecutor executor;
+        Channel<int> channel(executor);
+        auto waiter = [&]() -> Task {
+            Guard guard;
+            co_await channel.pop();
+        };
+        executor.spawn(waiter());
+        executor.spawn(waiter());
+        executor.spawn([&]() -> Task {
+            Guard guard;
+            co_return;
+        }());
+        ASSERT_EQ(executor.run(), 2);
+        ASSERT_EQ(alive, 2);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(ChannelTest, ThreadSafe) {
+    const int producers = 4, consumers = 3, perProducer = 20000;
+    ThreadSafeExecutor executor(4);
+    Channel<int> channel(executor, 128);
+    std::atomic<int> running(producers);
+    std::atomic<std::int64_t> sum(0), count(0);
+
+    auto producer = [&](int id) -> Task {
+        for (int i = 0; i < perProducer; ++i) {
+            co_await channel.push(id * perProducer + i);
+        }
+        if (--running == 0) {
+            channel.close();
+        }
+    };
+    auto consumer = [&]() -> Task {
+        while (auto value = co_await channel.pop()) {
+            sum += *value;
+            ++count;
+        }
+    };
+    for (int i = 0; i < consumers; ++i) {
+        executor.spawn(consumer());
+    }
+    for (int i = 0; i < producers; ++i) {
+        executor.spawn(producer(i));
+    }
+    executor.wait();
+    std::int64_t n = producers * perProducer;
+    ASSERT_EQ(count.load(), n);
+    ASSERT_EQ(sum.load(), n * (n - 1) / 2);
+}
+
+TEST(ChannelTimeTest, TimeMeasurement) {
+    const std::uint64_t n = 1000000;
+    const int stages = 3;
+    const std::size_t capacity = 256;
+
+    std::uint64_t channelSum = 0;
+    MEASURE_TIME_BEGIN(channelMs);
+    {
+        SingleThreadExecutor executor;
+        std::vector<std::unique_ptr<Channel<std::uint64_t>>> channels;
+        for (int i = 0; i <= stages; ++i) {
+            channels.emplace_back(new Channel<std::uint64_t>(executor, capacity));
+        }
+        executor.spawn(feed(*channels[0], n));
+        for (int i = 0; i < stages; ++i) {
+            executor.spawn(increment(*channels[i], *channels[i + 1]));
+        }
+        executor.spawn(sum_up(*channels[stages], channelSum));
+        executor.run();
+    }
+    MEASURE_TIME_END(channelMs);
+
+    std::uint64_t threadSum = 0;
+    MEASURE_TIME_BEGIN(threadMs);
+    {
+        std::vector<std::unique_ptr<BlockingQueue<std::uint64_t>>> queues;
+        for (int i = 0; i <= stages; ++i) {
+            queues.emplace_back(new BlockingQueue<std::uint64_t>(capacity));
+        }
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]() {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                queues[0]->push(i);
+            }
+            queues[0]->close();
+        });
+        for (int i = 0; i < stages; ++i) {
+            threads.emplace_back([&, i]() {
+                std::uint64_t value;
+                while (queues[i]->pop(value)) {
+                    queues[i + 1]->push(value + 1);
+                }
+                queues[i + 1]->close();
+            });
+        }
+        std::uint64_t value;
+        while (queues[stages]->pop(value)) {
+            threadSum += value;
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+    MEASURE_TIME_END(threadMs);
+
+    ASSERT_EQ(channelSum, threadSum);
+    std::cout   << "Pipeline of " << stages << " stages, " << n << " values" << std::endl
+                << "Coroutine channels time: " << channelMs << " ms." << std::endl
+                << "Thread per stage time: " << threadMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(channelMs, "Coroutine channels", n);
+    MEASURE_PERF_REPORT(threadMs, "Thread per stage", n);
+}
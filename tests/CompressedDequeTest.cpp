@@ -0,0 +1,119 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <CompressedDeque.h>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include "Measure.h"
+
+TEST(CompressedDequeTest, MatchesStdDeque) {
+    CompressedDeque values;
+    std::deque<std::int64_t> expected;
+    std::mt19937_64 gen(12);
+    std::int64_t last = 0;
+    for (int i = 0; i < 200000; ++i) {
+        unsigned op = gen() % 10;
+        std::int64_t value = gen() % 7 == 0 ? static_cast<std::int64_t>(gen()) : last + static_cast<int>(gen() % 100) - 20;
+        last = value;
+        if (expected.empty() || op < 3) {
+            values.push_back(value);
+            expected.push_back(value);
+        } else if (op < 5) {
+            values.push_front(value);
+            expected.push_front(value);
+        } else if (op < 7) {
+            values.pop_front();
+            expected.pop_front();
+        } else if (op < 8) {
+            values.pop_back();
+            expected.pop_back();
+        } else if (!expected.empty()) {
+            std::size_t n = gen() % expected.size();
+            ASSERT_EQ(values[n], expected[n]);
+        }
+        ASSERT_EQ(values.size(), expected.size());
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(values[i], expected[i]);
+    }
+}
+
+TEST(CompressedDequeTest, ExtremeValues) {
+    CompressedDeque values;
+    std::vector<std::int64_t> expected;
+    for (int i = 0; i < 1000; ++i) {
+        std::int64_t value = i % 2 == 0 ? std::numeric_limits<std::int64_t>::min() + i :
+                                          std::numeric_limits<std::int64_t>::max() - i;
+        values.push_back(value);
+        expected.push_back(value);
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(values[i], expected[i]);
+    }
+    while (!values.empty()) {
+        ASSERT_EQ(values.back(), expected.back());
+        values.pop_back();
+        expected.pop_back();
+    }
+    ASSERT_EQ(values.memory_bytes(), 0);
+    ASSERT_THROW(values.pop_front(), std::runtime_error);
+}
+
+TEST(CompressedDequeTimeTest, TimeMeasurement) {
+    const std::size_t n = 10000000, lookups = 1000000;
+    CompressedDeque compressed;
+    Deque<std::int64_t> plain;
+    std::mt19937_64 gen(13);
+    std::int64_t timestamp = 1700000000000000000ll;
+    for (std::size_t i = 0; i < n; ++i) {
+        timestamp += 1000 + gen() % 50000;
+        compressed.push_back(timestamp);
+        plain.push_back(timestamp);
+    }
+    std::vector<std::size_t> indices(lookups);
+    for (auto &index : indices) {
+        index = gen() % n;
+    }
+    std::int64_t plainSum = 0, compressedSum = 0;
+
+    MEASURE_TIME_BEGIN(plainScanMs);
+    for (std::size_t i = 0; i < n; ++i) {
+        plainSum += plain[i];
+    }
+    MEASURE_TIME_END(plainScanMs);
+
+    MEASURE_TIME_BEGIN(compressedScanMs);
+    for (std::size_t i = 0; i < n; ++i) {
+        compressedSum += compressed[i];
+    }
+    MEASURE_TIME_END(compressedScanMs);
+
+    MEASURE_TIME_BEGIN(plainRandomMs);
+    for (std::size_t index : indices) {
+        plainSum += plain[index];
+    }
+    MEASURE_TIME_END(plainRandomMs);
+
+    MEASURE_TIME_BEGIN(compressedRandomMs);
+    for (std::size_t index : indices) {
+        compressedSum += compressed[index];
+    }
+    MEASURE_TIME_END(compressedRandomMs);
+
+    ASSERT_EQ(plainSum, compressedSum);
+    std::cout   << "Compression ratio: " << double(n * sizeof(std::int64_t)) / compressed.memory_bytes() << std::endl
+                << "Sequential access, Deque: " << plainScanMs << " ms., CompressedDeque: "
+                << compressedScanMs << " ms." << std::endl
+                << "Random access, Deque: " << plainRandomMs << " ms., CompressedDeque: "
+                << compressedRandomMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(plainScanMs, "Sequential Deque", n);
+    MEASURE_PERF_REPORT(compressedScanMs, "Sequential CompressedDeque", n);
+    MEASURE_PERF_REPORT(plainRandomMs, "Random Deque", lookups);
+    MEASURE_PERF_REPORT(compressedRandomMs, "Random CompressedDeque", lookups);
+}
@@ -0,0 +1,237 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <ConcurrentDeque.h>
+#include <Deque.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+    // Keys run consecutively from front to back; check detects torn copies.
+    struct Entry {
+        std::uint64_t key, gen, check;
+    };
+
+    Entry make_entry(std::uint64_t key, std::uint64_t gen) {
+        return Entry{key, gen, key * 0x9E3779B97F4A7C15ull ^ gen};
+    }
+
+    bool intact(const Entry &entry) {
+        return entry.check == (entry.key * 0x9E3779B97F4A7C15ull ^ entry.gen);
+    }
+}
+
+TEST(ConcurrentDequeTest, SingleThread) {
+    ConcurrentDeque<int> deque;
+    std::deque<int> model;
+    auto reader = deque.reader();
+    std::mt19937 gen(17);
+    int value;
+    for (int i = 0; i < 200000; ++i) {
+        int op = gen() % 4;
+        if (op == 0 && !model.empty()) {
+            deque.pop_front();
+            model.pop_front();
+        } else if (op == 1 && !model.empty()) {
+            deque.pop_back();
+            model.pop_back();
+        } else if (op == 2) {
+            deque.push_front(i);
+            model.push_front(i);
+        } else {
+            deque.push_back(i);
+            model.push_back(i);
+        }
+        ASSERT_EQ(deque.size(), model.size());
+        if (!model.empty()) {
+            std::size_t n = gen() % model.size();
+            ASSERT_TRUE(reader.get(n, value));
+            ASSERT_EQ(value, model[n]);
+            ASSERT_TRUE(reader.get_from_back(n, value));
+            ASSERT_EQ(value, model[model.size() - 1 - n]);
+        }
+        ASSERT_FALSE(reader.get(model.size(), value));
+    }
+
+    std::vector<int> visited;
+    reader.for_each([&visited](int x) {
+        visited.push_back(x);
+    });
+    ASSERT_EQ(visited, std::vector<int>(model.begin(), model.end()));
+
+    while (!deque.empty()) {
+        deque.pop_front();
+    }
+    ASSERT_FALSE(reader.front(value));
+    ASSERT_THROW(deque.pop_back(), std::runtime_error);
+}
+
+TEST(ConcurrentDequeTest, ReaderSlots) {
+    ConcurrentDeque<int> deque;
+    std::vector<ConcurrentDeque<int>::Reader> readers;
+    for (std::size_t i = 0; i < ConcurrentDeque<int>::MAX_READERS; ++i) {
+        readers.push_back(deque.reader());
+    }
+    ASSERT_THROW(deque.reader(), std::runtime_error);
+    readers.pop_back();
+    auto reader = deque.reader();
+    deque.push_back(5);
+    int value;
+    ASSERT_TRUE(reader.back(value));
+    ASSERT_EQ(value, 5);
+}
+
+TEST(ConcurrentDequeTest, ConcurrentReaders) {
+    ConcurrentDeque<Entry> deque;
+    std::atomic<bool> done(false);
+    std::atomic<std::uint64_t> failures(0);
+
+    auto read = [&deque, &done, &failures]() {
+        auto reader = deque.reader();
+        Entry entry;
+        std::mt19937 gen(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        while (!done.load()) {
+            if (reader.front(entry) && !intact(entry)) {
+                ++failures;
+            }
+            if (reader.get_from_back(gen() % 100, entry) && !intact(entry)) {
+                ++failures;
+            }
+            bool first = true;
+            std::uint64_t last = 0;
+            reader.for_each([&](const Entry &e) {
+                if (!intact(e) || (!first && e.key <= last)) {
+                    ++failures;
+                }
+                first = false;
+                last = e.key;
+            });
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back(read);
+    }
+
+    std::mt19937 gen(42);
+    std::uint64_t frontKey = 0, backKey = 0;
+    for (std::uint64_t i = 0; i < 300000; ++i) {
+        int op = gen() % 8;
+        if (op < 2 && backKey != frontKey) {
+            deque.pop_front();
+            ++frontKey;
+        } else if (op == 2 && backKey != frontKey) {
+            deque.pop_back();
+            --backKey;
+        } else if (op == 3) {
+            deque.push_front(make_entry(--frontKey, i));
+        } else {
+            deque.push_back(make_entry(backKey++, i));
+        }
+    }
+    done.store(true);
+    for (auto &thread : readers) {
+        thread.join();
+    }
+    ASSERT_EQ(failures.load(), 0u);
+    ASSERT_EQ(deque.size(), backKey - frontKey);
+}
+
+TEST(ConcurrentDequeTimeTest, TimeMeasurement) {
+    const std::size_t elements = 100000, writes = 2000000;
+    const int readerCount = 3;
+
+    // Writer cycles a queue of fixed length while readers look elements up.
+    auto run_concurrent = [&](int readers, std::uint64_t &reads) {
+        ConcurrentDeque<std::uint64_t> deque;
+        for (std::size_t i = 0; i < elements; ++i) {
+            deque.push_back(i);
+        }
+        std::atomic<bool> done(false);
+        std::atomic<std::uint64_t> total(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < readers; ++i) {
+            threads.emplace_back([&]() {
+                auto reader = deque.reader();
+                std::uint64_t value, count = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    count += reader.get(count % elements, value);
+                }
+                total += count;
+            });
+        }
+        MEASURE_TIME_BEGIN(writerMs);
+        for (std::size_t i = 0; i < writes; ++i) {
+            deque.push_back(i);
+            deque.pop_front();
+        }
+        MEASURE_TIME_END(writerMs);
+        MEASURE_PERF_REPORT(writerMs, readers == 0 ? "ConcurrentDeque writer alone" : "ConcurrentDeque writer with readers", writes);
+        done.store(true);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        reads = total.load();
+        return writerMs;
+    };
+
+    std::atomic<std::uint64_t> sink(0);
+    auto run_locked = [&](int readers, std::uint64_t &reads) {
+        Deque<std::uint64_t> deque;
+        std::mutex mutex;
+        for (std::size_t i = 0; i < elements; ++i) {
+            deque.push_back(i);
+        }
+        std::atomic<bool> done(false);
+        std::atomic<std::uint64_t> total(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < readers; ++i) {
+            threads.emplace_back([&]() {
+                std::uint64_t value = 0, count = 0;
+                while (!done.load(std::memory_order_relaxed)) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    value += deque[count % elements];
+                    ++count;
+                }
+                total += count;
+                sink += value;
+            });
+        }
+        MEASURE_TIME_BEGIN(writerMs);
+        for (std::size_t i = 0; i < writes; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            deque.push_back(i);
+            deque.pop_front();
+        }
+        MEASURE_TIME_END(writerMs);
+        MEASURE_PERF_REPORT(writerMs, readers == 0 ? "Locked Deque writer alone" : "Locked Deque writer with readers", writes);
+        done.store(true);
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        reads = total.load();
+        return writerMs;
+    };
+
+    std::uint64_t reads = 0, lockedReads = 0;
+    double aloneMs = run_concurrent(0, reads);
+    double concurrentMs = run_concurrent(readerCount, reads);
+    double lockedAloneMs = run_locked(0, lockedReads);
+    double lockedMs = run_locked(readerCount, lockedReads);
+
+    std::cout   << "Writer ops: " << writes << " push_back/pop_front pairs, " << readerCount << " readers" << std::endl
+                << "ConcurrentDeque writer time alone: " << aloneMs << " ms." << std::endl
+                << "ConcurrentDeque writer time with readers: " << concurrentMs << " ms., reads: " << reads << std::endl
+                << "Locked Deque writer time alone: " << lockedAloneMs << " ms." << std::endl
+                << "Locked Deque writer time with readers: " << lockedMs << " ms., reads: " << lockedReads << std::endl;
+}
@@ -0,0 +1,174 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <DequeAlgorithms.h>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+template <class T>
+void fillBothEnds(Deque<T> &deque, const std::vector<T> &values) {
+    // Alternate ends so that segments start at arbitrary offsets.
+    std::size_t half = values.size() / 2;
+    for (std::size_t i = half; i-- > 0;) {
+        deque.push_front(values[i]);
+    }
+    for (std::size_t i = half; i < values.size(); ++i) {
+        deque.push_back(values[i]);
+    }
+}
+
+}
+
+TEST(DequeAlgorithmsTest, KernelsMatchScalar) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(-20, 20);
+    for (std::size_t n = 1; n < 70; ++n) {
+        std::vector<int> ints(n);
+        std::vector<float> floats(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ints[i] = dist(gen);
+            floats[i] = dist(gen) * 0.5f;
+        }
+        for (int value = -3; value <= 3; ++value) {
+            ASSERT_EQ(SimdKernels<int>::find(ints.data(), n, value),
+                      ScalarKernels<int>::find(ints.data(), n, value));
+            ASSERT_EQ(SimdKernels<int>::count(ints.data(), n, value),
+                      ScalarKernels<int>::count(ints.data(), n, value));
+            ASSERT_EQ(SimdKernels<float>::find(floats.data(), n, value * 0.5f),
+                      ScalarKernels<float>::find(floats.data(), n, value * 0.5f));
+            ASSERT_EQ(SimdKernels<float>::count(floats.data(), n, value * 0.5f),
+                      ScalarKernels<float>::count(floats.data(), n, value * 0.5f));
+        }
+        ASSERT_EQ(SimdKernels<int>::sum(ints.data(), n), ScalarKernels<int>::sum(ints.data(), n));
+        ASSERT_EQ(SimdKernels<float>::sum(floats.data(), n), ScalarKernels<float>::sum(floats.data(), n));
+        ASSERT_EQ(SimdKernels<int>::min_index(ints.data(), n), ScalarKernels<int>::min_index(ints.data(), n));
+        ASSERT_EQ(SimdKernels<int>::max_index(ints.data(), n), ScalarKernels<int>::max_index(ints.data(), n));
+        ASSERT_EQ(SimdKernels<float>::min_index(floats.data(), n),
+                  ScalarKernels<float>::min_index(floats.data(), n));
+        ASSERT_EQ(SimdKernels<float>::max_index(floats.data(), n),
+                  ScalarKernels<float>::max_index(floats.data(), n));
+    }
+}
+
+TEST(DequeAlgorithmsTest, MatchesStd) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+    std::vector<int> values(5000);
+    for (auto &value : values) {
+        value = dist(gen);
+    }
+    Deque<int> deque;
+    ASSERT_TRUE(deque_find(deque, 1) == deque.end());
+    ASSERT_TRUE(deque_min_element(deque) == deque.end());
+    ASSERT_EQ(deque_sum(deque), 0);
+    fillBothEnds(deque, values);
+
+    for (int value : {values[0], values[2500], values[4999], 5000}) {
+        ASSERT_EQ(deque_find(deque, value) - deque.begin(),
+                  std::find(values.begin(), values.end(), value) - values.begin());
+        ASSERT_EQ(deque_count(deque, value), std::count(values.begin(), values.end(), value));
+        ASSERT_EQ(deque_contains(deque, value), value != 5000);
+    }
+    ASSERT_EQ(deque_sum(deque), std::accumulate(values.begin(), values.end(), 0));
+    ASSERT_EQ(deque_min_element(deque) - deque.begin(),
+              std::min_element(values.begin(), values.end()) - values.begin());
+    ASSERT_EQ(deque_max_element(deque) - deque.begin(),
+              std::max_element(values.begin(), values.end()) - values.begin());
+
+    const Deque<int> &constDeque = deque;
+    ASSERT_EQ(*deque_max_element(constDeque), *std::max_element(values.begin(), values.end()));
+    *deque_find(deque, values[10]) = 1 << 20;
+    ASSERT_EQ(*deque_max_element(deque), 1 << 20);
+}
+
+TEST(DequeAlgorithmsTest, SumWrapsAround) {
+    std::vector<std::int32_t> values(3000, 2000000000);
+    std::uint32_t expected = 0;
+    for (std::int32_t value : values) {
+        expected += static_cast<std::uint32_t>(value);
+    }
+    ASSERT_EQ(SimdKernels<std::int32_t>::sum(values.data(), values.size()),
+              ScalarKernels<std::int32_t>::sum(values.data(), values.size()));
+    Deque<std::int32_t> deque;
+    fillBothEnds(deque, values);
+    ASSERT_EQ(static_cast<std::uint32_t>(deque_sum(deque)), expected);
+
+    Deque<std::int64_t> longs;
+    longs.push_back(INT64_MAX);
+    longs.push_back(1);
+    ASSERT_EQ(deque_sum(longs), INT64_MIN);
+}
+
+TEST(DequeAlgorithmsTest, ScalarFallback) {
+    Deque<std::string> deque;
+    std::vector<std::string> values = {"b", "a", "c", "a", "d"};
+    fillBothEnds(deque, values);
+    ASSERT_EQ(deque_count(deque, std::string("a")), 2);
+    ASSERT_EQ(deque_find(deque, std::string("c")) - deque.begin(), 2);
+    ASSERT_EQ(deque_min_element(deque) - deque.begin(), 1);
+    ASSERT_EQ(*deque_max_element(deque), "d");
+    ASSERT_EQ(deque_sum(deque), "bacad");
+}
+
+TEST(DequeAlgorithmsTimeTest, TimeMeasurement) {
+    const std::size_t n = 10000000;
+    Deque<int> ints;
+    Deque<float> floats;
+    for (std::size_t i = 0; i < n; ++i) {
+        ints.push_back(static_cast<int>(i % 1000));
+        floats.push_back(static_cast<float>(i % 1000));
+    }
+    const Deque<int> &cints = ints;
+    const Deque<float> &cfloats = floats;
+
+    MEASURE_TIME_BEGIN(stdIntMs);
+    long long stdInt = (std::find(cints.begin(), cints.end(), -1) - cints.begin()) +
+                       std::count(cints.begin(), cints.end(), 7) +
+                       *std::min_element(cints.begin(), cints.end()) +
+                       *std::max_element(cints.begin(), cints.end()) +
+                       std::accumulate(cints.begin(), cints.end(), 0);
+    MEASURE_TIME_END(stdIntMs);
+
+    MEASURE_TIME_BEGIN(simdIntMs);
+    long long simdInt = (deque_find(cints, -1) - cints.begin()) +
+                        deque_count(cints, 7) +
+                        *deque_min_element(cints) +
+                        *deque_max_element(cints) +
+                        deque_sum(cints);
+    MEASURE_TIME_END(simdIntMs);
+
+    MEASURE_TIME_BEGIN(stdFloatMs);
+    double stdFloat = (std::find(cfloats.begin(), cfloats.end(), -1.0f) - cfloats.begin()) +
+                      std::count(cfloats.begin(), cfloats.end(), 7.0f) +
+                      *std::min_element(cfloats.begin(), cfloats.end()) +
+                      *std::max_element(cfloats.begin(), cfloats.end());
+    MEASURE_TIME_END(stdFloatMs);
+
+    MEASURE_TIME_BEGIN(simdFloatMs);
+    double simdFloat = (deque_find(cfloats, -1.0f) - cfloats.begin()) +
+                       deque_count(cfloats, 7.0f) +
+                       *deque_min_element(cfloats) +
+                       *deque_max_element(cfloats);
+    MEASURE_TIME_END(simdFloatMs);
+
+    ASSERT_EQ(stdInt, simdInt);
+    ASSERT_EQ(stdFloat, simdFloat);
+    std::cout   << "Scan of " << n << " elements (find, count, min, max, sum)" << std::endl
+                << "std:: over DequeIterator, int: " << stdIntMs << " ms." << std::endl
+                << "Deque algorithms, int: " << simdIntMs << " ms." << std::endl
+                << "std:: over DequeIterator, float: " << stdFloatMs << " ms." << std::endl
+                << "Deque algorithms, float: " << simdFloatMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(stdIntMs, "std:: int", n);
+    MEASURE_PERF_REPORT(simdIntMs, "Deque algorithms int", n);
+    MEASURE_PERF_REPORT(stdFloatMs, "std:: float", n);
+    MEASURE_PERF_REPORT(simdFloatMs, "Deque algorithms float", n);
+}
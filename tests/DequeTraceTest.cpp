@@ -0,0 +1,157 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <DequeTrace.h>
+#include <Deque.h>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <random>
+#include <string>
+#include <unistd.h>
+
+TEST(DequeTraceTest, RoundTrip) {
+    Trace trace;
+    RecordingDeque<std::int64_t> recorded(&trace, TRACE_RAW_VALUES);
+    std::deque<std::int64_t> expected;
+    std::mt19937_64 gen(11);
+    std::uint64_t checksum = 0;
+    for (int i = 0; i < 50000; ++i) {
+        int op = gen() % 6;
+        std::int64_t value = static_cast<std::int64_t>(gen()) >> (gen() % 64);
+        std::uint64_t read = 0;
+        if (op == 0) {
+            recorded.push_back(value);
+            expected.push_back(value);
+        } else if (op == 1) {
+            recorded.push_front(-value);
+            expected.push_front(-value);
+        } else if (op == 2 && !expected.empty()) {
+            recorded.pop_back();
+            expected.pop_back();
+        } else if (op == 3 && !expected.empty()) {
+            recorded.pop_front();
+            expected.pop_front();
+        } else if (op == 4 && !expected.empty()) {
+            std::size_t n = gen() % expected.size();
+            ASSERT_EQ(recorded[n], expected[n]);
+            read = expected[n];
+        } else if (op == 5 && i % 100 == 0) {
+            recorded.for_each([&read](std::int64_t x) {
+                read += x;
+            });
+        } else {
+            continue;
+        }
+        checksum = checksum * 31 + read;
+    }
+    recorded.attach(nullptr);
+    recorded.push_back(1);
+    recorded.pop_back();
+
+    std::string path = "/tmp/deque_trace_" + std::to_string(getpid());
+    trace.save(path);
+    Trace loaded = Trace::load(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(loaded.size(), trace.size());
+    ASSERT_EQ(loaded.bytes_size(), trace.bytes_size());
+
+    auto records = loaded.decode();
+    ASSERT_EQ(records.size(), trace.size());
+    Deque<std::int64_t> deque;
+    std::deque<std::int64_t> stdDeque;
+    ASSERT_EQ(replay_trace(records, deque), checksum);
+    ASSERT_EQ(replay_trace(records, stdDeque), checksum);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), deque.begin()));
+    ASSERT_EQ(stdDeque, expected);
+}
+
+TEST(DequeTraceTest, AnonymizedAndAttachedLate) {
+    RecordingDeque<std::int64_t> recorded;
+    recorded.push_back(10);
+    recorded.push_back(20);
+    Trace trace;
+    recorded.attach(&trace);
+    recorded.push_front(30);
+    recorded.pop_back();
+    recorded[1];
+
+    auto records = trace.decode();
+    ASSERT_EQ(records.size(), 5);
+    for (const TraceRecord &record : records) {
+        if (record.op == TRACE_PUSH_BACK || record.op == TRACE_PUSH_FRONT) {
+            ASSERT_EQ(record.arg, 0);
+        }
+    }
+    Deque<std::int64_t> deque;
+    replay_trace(records, deque);
+    ASSERT_EQ(deque.size(), recorded.size());
+
+    Trace bad;
+    bad.append(TRACE_PUSH_BACK, 1);
+    bad.append(TRACE_AT, 1);
+    std::deque<std::int64_t> stdDeque;
+    ASSERT_THROW(replay_trace(bad.decode(), stdDeque), std::runtime_error);
+    bad.append(TRACE_POP_FRONT);
+    bad.append(TRACE_POP_FRONT);
+    auto pops = bad.decode();
+    pops.erase(pops.begin() + 1);
+    stdDeque.clear();
+    ASSERT_THROW(replay_trace(pops, stdDeque), std::runtime_error);
+}
+
+TEST(DequeTraceTest, StreamsToFile) {
+    std::string path = "/tmp/deque_trace_stream_" + std::to_string(getpid());
+    Trace memory;
+    {
+        Trace stream(path, 256);
+        ASSERT_TRUE(stream.streaming());
+        RecordingDeque<std::int64_t> recorded(&stream, TRACE_RAW_VALUES);
+        RecordingDeque<std::int64_t> reference(&memory, TRACE_RAW_VALUES);
+        for (std::int64_t i = 0; i < 10000; ++i) {
+            recorded.push_back(i);
+            reference.push_back(i);
+            if (i % 3 == 0) {
+                recorded.pop_front();
+                reference.pop_front();
+            }
+            ASSERT_LT(stream.buffered_size(), 256);
+        }
+        ASSERT_EQ(stream.size(), memory.size());
+        ASSERT_EQ(stream.bytes_size(), memory.bytes_size());
+        ASSERT_THROW(stream.decode(), std::runtime_error);
+        ASSERT_THROW(stream.save(path + ".copy"), std::runtime_error);
+        ASSERT_LT(Trace::load(path).size(), memory.size());
+        recorded.attach(nullptr);
+    }
+    Trace loaded = Trace::load(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(loaded.size(), memory.size());
+    auto records = loaded.decode();
+    auto expected = memory.decode();
+    ASSERT_EQ(records.size(), expected.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(records[i].op, expected[i].op);
+        ASSERT_EQ(records[i].arg, expected[i].arg);
+    }
+    ASSERT_THROW(Trace("/nonexistent/deque_trace"), std::runtime_error);
+}
+
+TEST(DequeTraceTest, BadFiles) {
+    std::string path = "/tmp/deque_trace_bad_" + std::to_string(getpid());
+    ASSERT_THROW(Trace::load(path), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "NOTATRACE";
+    }
+    ASSERT_THROW(Trace::load(path), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "DQTRACE1" << '\0' << '\xff';
+    }
+    ASSERT_THROW(Trace::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
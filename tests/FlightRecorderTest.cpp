@@ -0,0 +1,118 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <FlightRecorder.h>
+#include <RingBuffer.h>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+struct Event {
+    std::uint64_t seq;
+    std::uint64_t payload[3];
+};
+
+}
+
+TEST(FlightRecorderTest, KeepsLatest) {
+    FlightRecorder<Event> recorder(1000);
+    ASSERT_EQ(recorder.capacity(), 1024);
+
+    std::vector<Event> out(recorder.capacity());
+    std::uint64_t firstSeq = 42;
+    ASSERT_EQ(recorder.snapshot(out.data(), &firstSeq), 0);
+    ASSERT_EQ(firstSeq, 0);
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        recorder.record(Event{i, {i, i, i}});
+    }
+    ASSERT_EQ(recorder.snapshot(out.data(), &firstSeq), 100);
+    ASSERT_EQ(firstSeq, 0);
+    ASSERT_EQ(out[99].seq, 99);
+
+    for (std::uint64_t i = 100; i < 5000; ++i) {
+        recorder.record(Event{i, {i, i, i}});
+    }
+    ASSERT_EQ(recorder.recorded(), 5000);
+    ASSERT_EQ(recorder.size(), 1024);
+    ASSERT_EQ(recorder.snapshot(out.data(), &firstSeq), 1024);
+    ASSERT_EQ(firstSeq, 5000 - 1024);
+    for (std::size_t i = 0; i < 1024; ++i) {
+        ASSERT_EQ(out[i].seq, firstSeq + i);
+    }
+}
+
+TEST(FlightRecorderTest, ConcurrentSnapshots) {
+    FlightRecorder<Event> recorder(256);
+    std::atomic<bool> done(false);
+    std::thread writer([&recorder, &done]() {
+        for (std::uint64_t i = 0; i < 2000000; ++i) {
+            recorder.record(Event{i, {i, i + 1, i + 2}});
+        }
+        done = true;
+    });
+
+    std::vector<Event> out(recorder.capacity());
+    std::size_t snapshots = 0;
+    while (!done || snapshots == 0) {
+        std::uint64_t firstSeq;
+        std::size_t n = recorder.snapshot(out.data(), &firstSeq);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(out[i].seq, firstSeq + i);
+            ASSERT_EQ(out[i].payload[0], out[i].seq);
+            ASSERT_EQ(out[i].payload[2], out[i].seq + 2);
+        }
+        ++snapshots;
+    }
+    writer.join();
+}
+
+TEST(FlightRecorderTest, TimeMeasurement) {
+    const std::size_t capacity = 1 << 20, n = 20000000;
+    std::vector<Event> out(capacity);
+
+    MEASURE_TIME_BEGIN(vectorMs);
+    std::vector<Event> log(capacity);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        log[i % capacity] = Event{i, {i, i, i}};
+    }
+    MEASURE_TIME_END(vectorMs);
+
+    MEASURE_TIME_BEGIN(ringMs);
+    RingBuffer<Event> ring(capacity);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        ring.push_back_overwrite(Event{i, {i, i, i}});
+    }
+    MEASURE_TIME_END(ringMs);
+
+    MEASURE_TIME_BEGIN(recorderMs);
+    FlightRecorder<Event> recorder(capacity);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        recorder.record(Event{i, {i, i, i}});
+    }
+    MEASURE_TIME_END(recorderMs);
+
+    MEASURE_TIME_BEGIN(dumpMs);
+    std::uint64_t firstSeq;
+    std::size_t dumped = recorder.snapshot(out.data(), &firstSeq);
+    MEASURE_TIME_END(dumpMs);
+
+    ASSERT_EQ(dumped, capacity);
+    ASSERT_EQ(out.back().seq, n - 1);
+    ASSERT_EQ(ring.front().seq, out.front().seq);
+    std::cout   << "vector with modulo time: " << vectorMs << " ms." << std::endl
+                << "RingBuffer overwrite time: " << ringMs << " ms." << std::endl
+                << "FlightRecorder time: " << recorderMs << " ms." << std::endl
+                << "FlightRecorder dump time: " << dumpMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(vectorMs, "vector with modulo", n);
+    MEASURE_PERF_REPORT(ringMs, "RingBuffer overwrite", n);
+    MEASURE_PERF_REPORT(recorderMs, "FlightRecorder", n);
+    MEASURE_PERF_REPORT(dumpMs, "FlightRecorder dump", capacity);
+}
@@ -0,0 +1,93 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Deque.h>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+#include "Measure.h"
+
+TEST(GatherTest, GatherScatter) {
+    Deque<std::string> deque;
+    for (int i = 0; i < 3000; ++i) {
+        deque.push_back(std::to_string(i));
+        deque.push_front(std::to_string(-i));
+    }
+    std::mt19937 gen(14);
+    std::vector<std::size_t> indices(1000);
+    for (auto &index : indices) {
+        index = gen() % deque.size();
+    }
+    std::vector<std::string> gathered;
+    deque.gather(indices.begin(), indices.end(), std::back_inserter(gathered));
+    ASSERT_EQ(gathered.size(), indices.size());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(gathered[i], deque[indices[i]]);
+    }
+
+    std::vector<std::size_t> targets = {0, 5999, 17, 3000};
+    std::vector<std::string> values = {"a", "b", "c", "d"};
+    deque.scatter(targets.begin(), targets.end(), values.begin());
+    ASSERT_EQ(deque.front(), "a");
+    ASSERT_EQ(deque.back(), "b");
+    ASSERT_EQ(deque[17], "c");
+    ASSERT_EQ(deque[3000], "d");
+
+    std::vector<std::size_t> none;
+    ASSERT_TRUE(deque.gather(none.begin(), none.end(), gathered.begin()) == gathered.begin());
+}
+
+TEST(GatherTimeTest, TimeMeasurement) {
+    const std::size_t n = 20000000, lookups = 5000000;
+    Deque<std::uint64_t> deque;
+    for (std::size_t i = 0; i < n; ++i) {
+        deque.push_back(i * 3);
+    }
+    std::mt19937_64 gen(15);
+    std::vector<std::size_t> indices(lookups);
+    for (auto &index : indices) {
+        index = gen() % n;
+    }
+    std::vector<std::uint64_t> naive(lookups), batched(lookups);
+
+    MEASURE_TIME_BEGIN(naiveMs);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        naive[i] = deque.at(indices[i]);
+    }
+    MEASURE_TIME_END(naiveMs);
+
+    MEASURE_TIME_BEGIN(gatherMs);
+    deque.gather(indices.begin(), indices.end(), batched.begin());
+    MEASURE_TIME_END(gatherMs);
+
+    ASSERT_EQ(naive, batched);
+
+    MEASURE_TIME_BEGIN(naiveScatterMs);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        deque.at(indices[i]) = i;
+    }
+    MEASURE_TIME_END(naiveScatterMs);
+
+    std::vector<std::uint64_t> values(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        values[i] = i;
+    }
+    MEASURE_TIME_BEGIN(scatterMs);
+    deque.scatter(indices.begin(), indices.end(), values.begin());
+    MEASURE_TIME_END(scatterMs);
+
+    std::cout   << "Random lookups: " << lookups << " into " << n << " elements" << std::endl
+                << "at() loop time: " << naiveMs << " ms." << std::endl
+                << "gather time: " << gatherMs << " ms." << std::endl
+                << "at() store loop time: " << naiveScatterMs << " ms." << std::endl
+                << "scatter time: " << scatterMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(naiveMs, "at() loop", lookups);
+    MEASURE_PERF_REPORT(gatherMs, "gather", lookups);
+    MEASURE_PERF_REPORT(naiveScatterMs, "at() store loop", lookups);
+    MEASURE_PERF_REPORT(scatterMs, "scatter", lookups);
+}
@@ -0,0 +1,221 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <GrowableRingBuffer.h>
+#include <Deque.h>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <iostream>
+#include "Measure.h"
+
+namespace {
+
+struct Tracked {
+    static int alive;
+    int value;
+
+    Tracked(int value = 0) : value(value) {
+        ++alive;
+    }
+
+    Tracked(const Tracked &other) : value(other.value) {
+        ++alive;
+    }
+
+    ~Tracked() {
+        --alive;
+    }
+};
+
+int Tracked::alive = 0;
+
+struct ThrowingCopy : Tracked {
+    static int copiesLeft;
+
+    ThrowingCopy(int value = 0) : Tracked(value) {
+    }
+
+    ThrowingCopy(const ThrowingCopy &other) : Tracked(other) {
+        if (copiesLeft-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+};
+
+int ThrowingCopy::copiesLeft = -1;
+
+struct Message {
+    std::uint64_t timestamp;
+    std::uint32_t id, flags;
+};
+
+}
+
+TEST(GrowableRingBufferTest, MatchesStdDeque) {
+    GrowableRingBuffer<int> ring;
+    std::deque<int> expected;
+    unsigned x = 1;
+    for (int i = 0; i < 100000; ++i) {
+        x = x * 1103515245 + 12345;
+        switch ((x >> 16) % 5) {
+            case 0:
+            case 1:
+                ring.push_back(i);
+                expected.push_back(i);
+                break;
+            case 2:
+                ring.push_front(i);
+                expected.push_front(i);
+                break;
+            case 3:
+                if (!expected.empty()) {
+                    ring.pop_front();
+                    expected.pop_front();
+                }
+                break;
+            case 4:
+                if (!expected.empty()) {
+                    ring.pop_back();
+                    expected.pop_back();
+                }
+                break;
+        }
+        ASSERT_EQ(ring.size(), expected.size());
+    }
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), ring.begin()));
+    ASSERT_EQ(ring.capacity() & (ring.capacity() - 1), 0);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(ring[i], expected[i]);
+    }
+    ASSERT_EQ(ring.front(), expected.front());
+    ASSERT_EQ(ring.back(), expected.back());
+}
+
+TEST(GrowableRingBufferTest, ConstructsAndDestroys) {
+    {
+        GrowableRingBuffer<Tracked> ring;
+        for (int i = 0; i < 1000; ++i) {
+            ring.push_front(Tracked(i));
+            ring.push_back(Tracked(i));
+        }
+        ASSERT_EQ(Tracked::alive, 2000);
+        for (int i = 0; i < 500; ++i) {
+            ring.pop_front();
+        }
+        ASSERT_EQ(Tracked::alive, 1500);
+
+        GrowableRingBuffer<Tracked> copy(ring);
+        ASSERT_EQ(Tracked::alive, 3000);
+        GrowableRingBuffer<Tracked> moved(std::move(copy));
+        ASSERT_EQ(Tracked::alive, 3000);
+        ASSERT_TRUE(copy.empty());
+    }
+    ASSERT_EQ(Tracked::alive, 0);
+
+    GrowableRingBuffer<std::string> strings;
+    for (int i = 0; i < 100; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    GrowableRingBuffer<std::string> other;
+    other = strings;
+    ASSERT_EQ(other[42], "42");
+    std::sort(other.begin(), other.end());
+    ASSERT_EQ(other.front(), "0");
+    ASSERT_EQ(other.back(), "99");
+    ASSERT_THROW(GrowableRingBuffer<int>().pop_back(), std::runtime_error);
+}
+
+TEST(GrowableRingBufferTest, ThrowingCopyDuringGrowth) {
+    {
+        GrowableRingBuffer<ThrowingCopy> ring;
+        ring.push_back(ThrowingCopy(0));
+        for (int i = 1; ring.size() != ring.capacity(); ++i) {
+            ring.push_front(ThrowingCopy(i));
+        }
+        std::size_t size = ring.size();
+        std::size_t capacity = ring.capacity();
+        int alive = Tracked::alive;
+        ThrowingCopy extra(-1);
+        ThrowingCopy::copiesLeft = 3;
+        ASSERT_THROW(ring.push_back(extra), std::runtime_error);
+        ThrowingCopy::copiesLeft = -1;
+        ASSERT_EQ(Tracked::alive, alive + 1);
+        ASSERT_EQ(ring.size(), size);
+        ASSERT_EQ(ring.capacity(), capacity);
+        ASSERT_EQ(ring.back().value, 0);
+        ring.push_back(extra);
+        ASSERT_EQ(ring.size(), size + 1);
+        ASSERT_EQ(ring.back().value, -1);
+    }
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(GrowableRingBufferTest, PushOwnElementWhileFull) {
+    GrowableRingBuffer<std::string> ring;
+    ring.push_back(std::string(100, 'a'));
+    while (ring.size() != ring.capacity()) {
+        ring.push_back(std::string(100, 'b'));
+    }
+    ring.push_back(ring.front());
+    ASSERT_EQ(ring.back(), std::string(100, 'a'));
+    while (ring.size() != ring.capacity()) {
+        ring.push_back(std::string(100, 'c'));
+    }
+    ring.push_front(ring.back());
+    ASSERT_EQ(ring.front(), std::string(100, 'c'));
+    while (ring.size() != ring.capacity()) {
+        ring.push_back(std::string(100, 'd'));
+    }
+    ring.push_back(std::move(ring.front()));
+    ASSERT_EQ(ring.back(), std::string(100, 'c'));
+}
+
+class GrowableRingBufferTimeTest : public testing::TestWithParam<std::size_t> {
+};
+
+TEST_P(GrowableRingBufferTimeTest, QueueTimeMeasurement) {
+    std::size_t n = GetParam();
+    const std::size_t window = 1000;
+    std::uint64_t sumDeque = 0, sumRing = 0;
+
+    MEASURE_TIME_BEGIN(dequeMs);
+    {
+        Deque<Message> queue;
+        for (std::size_t i = 0; i < n; ++i) {
+            queue.push_back(Message{i, static_cast<std::uint32_t>(i), 0});
+            if (i >= window) {
+                sumDeque += queue.front().timestamp;
+                queue.pop_front();
+            }
+        }
+    }
+    MEASURE_TIME_END(dequeMs);
+
+    MEASURE_TIME_BEGIN(ringMs);
+    {
+        GrowableRingBuffer<Message> queue;
+        for (std::size_t i = 0; i < n; ++i) {
+            queue.push_back(Message{i, static_cast<std::uint32_t>(i), 0});
+            if (i >= window) {
+                sumRing += queue.front().timestamp;
+                queue.pop_front();
+            }
+        }
+    }
+    MEASURE_TIME_END(ringMs);
+
+    ASSERT_EQ(sumDeque, sumRing);
+    std::cout   << "Deque queue time: " << dequeMs << " ms." << std::endl
+                << "GrowableRingBuffer queue time: " << ringMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(dequeMs, "Deque queue", n);
+    MEASURE_PERF_REPORT(ringMs, "GrowableRingBuffer queue", n);
+}
+
+INSTANTIATE_TEST_CASE_P(GrowableRingBufferTimeTest,
+                        GrowableRingBufferTimeTest,
+                        testing::Values(10000, 1000000, 10000000));
@@ -0,0 +1,99 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Deque.h>
+#include <HugePageResource.h>
+#include <cstdint>
+#include <iostream>
+#include "Measure.h"
+#include "PerfCounter.h"
+
+TEST(HugePageTest, CacheLineAligned) {
+    HugePageResource resource;
+    void *a = resource.allocate(24, 8);
+    void *b = resource.allocate(24, 8);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(a) % HugePageResource::CACHE_LINE, 0);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(b) % HugePageResource::CACHE_LINE, 0);
+    ASSERT_GE(reinterpret_cast<char *>(b) - reinterpret_cast<char *>(a), HugePageResource::CACHE_LINE);
+    ASSERT_EQ(resource.regions_count(), 1);
+
+    resource.deallocate(b, 24, 8);
+    ASSERT_EQ(resource.allocate(24, 8), b);
+
+    void *big = resource.allocate(3 * HugePageResource::REGION_SIZE, 8);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(big) % HugePageResource::REGION_SIZE, 0);
+    ASSERT_EQ(resource.regions_count(), 2);
+    resource.deallocate(big, 3 * HugePageResource::REGION_SIZE, 8);
+    ASSERT_EQ(resource.regions_count(), 1);
+}
+
+TEST(HugePageTest, DequeOnHugePages) {
+    HugePageResource resource;
+    Deque<long long, PolymorphicAllocator<long long>> d(&resource);
+    for (int i = 0; i < 100000; ++i) {
+        d.push_back(i);
+        d.push_front(-i);
+    }
+    for (std::size_t i = 0; i < d.getBlocksCount(); ++i) {
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(d.getBlocks()[i]->buffer) % HugePageResource::CACHE_LINE, 0);
+    }
+    long long sum = 0;
+    for (auto x : d) {
+        sum += x;
+    }
+    ASSERT_EQ(sum, 0);
+    while (!d.empty()) {
+        d.pop_front();
+    }
+}
+
+class HugePageTimeTest : public testing::TestWithParam<std::size_t> {
+protected:
+    template <class DequeType>
+    static void scan(const DequeType &d, const char *name) {
+        long long sum = 0;
+        MEASURE_TIME_BEGIN(scanMs);
+        for (int pass = 0; pass < 4; ++pass) {
+            for (auto segment : d.segments()) {
+                for (auto x : segment) {
+                    sum += x;
+                }
+            }
+        }
+        MEASURE_TIME_END(scanMs);
+        long long dtlbMisses = MEASURE_PERF(scanMs).value(PerfCounterSet::DTLB_MISSES);
+        std::cout << name << " scan time: " << scanMs << " ms, dTLB misses: ";
+        if (dtlbMisses >= 0) {
+            std::cout << dtlbMisses;
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << " (checksum " << sum << ")" << std::endl;
+        MEASURE_PERF_REPORT(scanMs, name, 4.0 * d.size());
+    }
+};
+
+TEST_P(HugePageTimeTest, ScanTimeMeasurement) {
+    std::size_t n = GetParam();
+    {
+        Deque<long long> d;
+        for (std::size_t i = 0; i < n; ++i) {
+            d.push_back(i);
+        }
+        scan(d, "std::allocator");
+    }
+    {
+        HugePageResource resource;
+        Deque<long long, PolymorphicAllocator<long long>> d(&resource);
+        for (std::size_t i = 0; i < n; ++i) {
+            d.push_back(i);
+        }
+        scan(d, "HugePageResource");
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(HugePageTimeTest,
+                        HugePageTimeTest,
+                        testing::Values(100000, 1000000, 10000000));
@@ -0,0 +1,26 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_MEASURE_H
+#define DEQUE_MEASURE_H
+
+#include <chrono>
+#include <iostream>
+
+#include "PerfCounter.h"
+
+// Every measurement also runs the hardware counters of PerfCounterSet; they
+// are opened before and read after the timed region.
+#define MEASURE_TIME_BEGIN(NAME) PerfCounterSet __##NAME##_perf; \
+                                 __##NAME##_perf.start(); \
+                                 std::chrono::steady_clock::time_point __##NAME##_begin = std::chrono::steady_clock::now()
+#define MEASURE_TIME_END(NAME)  std::chrono::steady_clock::time_point __##NAME##_end = std::chrono::steady_clock::now(); \
+                                __##NAME##_perf.stop(); \
+                                double NAME = std::chrono::duration_cast<std::chrono::nanoseconds>(__##NAME##_end - __##NAME##_begin).count() / 1e6;
+// The PerfCounterSet of measurement NAME, and one line of its counters
+// divided by OPERATIONS.
+#define MEASURE_PERF(NAME) __##NAME##_perf
+#define MEASURE_PERF_REPORT(NAME, LABEL, OPERATIONS) MEASURE_PERF(NAME).report(std::cout, LABEL, OPERATIONS)
+
+#endif //DEQUE_MEASURE_H
@@ -0,0 +1,179 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#ifndef DEQUE_PERFCOUNTER_H
+#define DEQUE_PERFCOUNTER_H
+
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Thin wrapper over a single perf_event_open counter for the calling thread
+// and the threads and processes it starts (their counts are folded in once
+// they exit). When the kernel refuses the event (no PMU, paranoid settings,
+// containers) available() is false and value() returns -1. If the PMU had to
+// multiplex the counter, value() is scaled up to the whole enabled time.
+class PerfCounter {
+private:
+    int fd_;
+public:
+    static const std::uint64_t DTLB_READ_MISS = PERF_COUNT_HW_CACHE_DTLB |
+                                                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    PerfCounter(std::uint32_t type, std::uint64_t config) : fd_(-1) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    PerfCounter(const PerfCounter &) = delete;
+    PerfCounter &operator =(const PerfCounter &) = delete;
+
+    ~PerfCounter() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    bool available() const {
+        return fd_ >= 0;
+    }
+
+    void start() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void stop() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    long long value() const {
+        // count, time enabled, time running
+        std::uint64_t data[3];
+        if (fd_ < 0 || read(fd_, data, sizeof(data)) != sizeof(data)) {
+            return -1;
+        }
+        if (data[2] == 0) {
+            return data[1] == 0 ? 0 : -1;
+        }
+        if (data[2] < data[1]) {
+            return static_cast<long long>(static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+        return static_cast<long long>(data[0]);
+    }
+};
+
+// The counters every benchmark reports: enough to tell instruction count
+// (e.g. the division in at()) from cache and TLB misses (the DataBlock
+// pointer chase). Events are opened one by one, so a missing event only
+// blanks its own column.
+class PerfCounterSet {
+public:
+    enum Event {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        BRANCH_MISSES,
+        EVENT_COUNT
+    };
+private:
+    std::unique_ptr<PerfCounter> counters_[EVENT_COUNT];
+public:
+    PerfCounterSet() {
+        const std::uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D |
+                                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        counters_[CYCLES].reset(new PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES));
+        counters_[INSTRUCTIONS].reset(new PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS));
+        counters_[L1D_MISSES].reset(new PerfCounter(PERF_TYPE_HW_CACHE, l1dReadMiss));
+        counters_[LLC_MISSES].reset(new PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES));
+        counters_[DTLB_MISSES].reset(new PerfCounter(PERF_TYPE_HW_CACHE, PerfCounter::DTLB_READ_MISS));
+        counters_[BRANCH_MISSES].reset(new PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES));
+    }
+
+    static const char *name(Event event) {
+        static const char *names[EVENT_COUNT] = {
+                "cycles", "instructions", "L1d misses", "LLC misses", "dTLB misses", "branch misses"
+        };
+        return names[event];
+    }
+
+    // True if at least one event could be opened.
+    bool available() const {
+        for (const auto &counter : counters_) {
+            if (counter->available()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() {
+        for (auto &counter : counters_) {
+            counter->start();
+        }
+    }
+
+    void stop() {
+        for (auto &counter : counters_) {
+            counter->stop();
+        }
+    }
+
+    long long value(Event event) const {
+        return counters_[event]->value();
+    }
+
+    // One line of counts divided by operations, "n/a" for missing events.
+    void report(std::ostream &out, const char *label, double operations) const {
+        out << label << " per op:";
+        if (!available()) {
+            out << " hardware counters n/a" << std::endl;
+            return;
+        }
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        long long values[EVENT_COUNT];
+        for (int i = 0; i < EVENT_COUNT; ++i) {
+            values[i] = value(static_cast<Event>(i));
+            out << (i == 0 ? " " : ", ") << name(static_cast<Event>(i)) << ' ';
+            if (values[i] < 0) {
+                out << "n/a";
+            } else {
+                out << values[i] / operations;
+            }
+        }
+        if (values[CYCLES] > 0 && values[INSTRUCTIONS] >= 0) {
+            out << ", IPC " << static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES];
+        }
+        out << std::endl;
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
+
+#endif //DEQUE_PERFCOUNTER_H
@@ -7,6 +7,7 @@
 #include <Deque.h>
 #include <deque>
 #include <chrono>
+#include "Measure.h"
 
 class PushPopTest : public testing::TestWithParam<std::size_t> {
 protected:
@@ -33,11 +34,6 @@ protected:
     std::deque<int> stdDeque;
 };
 
-#define MEASURE_TIME_BEGIN(NAME) std::chrono::steady_clock::time_point __##NAME##_begin = std::chrono::steady_clock::now()
-#define MEASURE_TIME_END(NAME)  std::chrono::steady_clock::time_point __##NAME##_end = std::chrono::steady_clock::now(); \
-                                double NAME = std::chrono::duration_cast<std::chrono::nanoseconds>(__##NAME##_end - __##NAME##_begin).count() / 1e6;
-
-
 TEST_P(PushPopTest, FifoOrder) {
     std::size_t n = GetParam();
     for (std::size_t i = 0; i < n; ++i) {
@@ -136,6 +132,8 @@ TEST_P(PushPopTest, TimeMeasurement) {
 
     std::cout   << "std::deque time: " << stdDequeMs << " ms." << std::endl
                 << "My Deque time: " << myDequeMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(stdDequeMs, "std::deque", 4.0 * n);
+    MEASURE_PERF_REPORT(myDequeMs, "My Deque", 4.0 * n);
 }
 
 TEST_P(PushPopTest, SortTimeMeasurement) {
@@ -170,7 +168,8 @@ TEST_P(PushPopTest, SortTimeMeasurement) {
 
     std::cout   << "std::deque time: " << stdDequeMs << " ms." << std::endl
                 << "My Deque time: " << myDequeMs << " ms." << std::endl;
-
+    MEASURE_PERF_REPORT(stdDequeMs, "std::deque fill and sort", 2.0 * n);
+    MEASURE_PERF_REPORT(myDequeMs, "My Deque fill and sort", 2.0 * n);
 }
 
 INSTANTIATE_TEST_CASE_P(PushPopTest,
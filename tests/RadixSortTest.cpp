@@ -0,0 +1,133 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Deque.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+template <class T>
+Deque<T> fromBothEnds(const std::vector<T> &values) {
+    Deque<T> deque;
+    std::size_t half = values.size() / 3;
+    for (std::size_t i = half; i-- > 0;) {
+        deque.push_front(values[i]);
+    }
+    for (std::size_t i = half; i < values.size(); ++i) {
+        deque.push_back(values[i]);
+    }
+    return deque;
+}
+
+template <class T>
+void expectSorted(std::vector<T> values) {
+    Deque<T> deque = fromBothEnds(values);
+    deque.radix_sort();
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(deque.size(), values.size());
+    ASSERT_TRUE(std::equal(values.begin(), values.end(), deque.begin()));
+}
+
+struct Event {
+    std::uint64_t timestamp;
+    std::string payload;
+};
+
+}
+
+TEST(RadixSortTest, Integral) {
+    std::mt19937_64 gen(1);
+    for (std::size_t n : {0, 1, 2, 255, 256, 257, 5000}) {
+        std::vector<std::uint64_t> timestamps(n);
+        std::vector<int> ints(n);
+        std::vector<std::int8_t> bytes(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            timestamps[i] = 1700000000000000000ull + gen() % 1000000000ull;
+            ints[i] = static_cast<int>(gen());
+            bytes[i] = static_cast<std::int8_t>(gen());
+        }
+        expectSorted(timestamps);
+        expectSorted(ints);
+        expectSorted(bytes);
+    }
+}
+
+TEST(RadixSortTest, FloatingPoint) {
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> doubles(3000);
+    std::vector<float> floats(3000);
+    for (std::size_t i = 0; i < doubles.size(); ++i) {
+        doubles[i] = dist(gen);
+        floats[i] = static_cast<float>(dist(gen) / 1e3);
+    }
+    doubles[0] = 0.0;
+    doubles[1] = -1e-300;
+    floats[0] = -0.5f;
+    expectSorted(doubles);
+    expectSorted(floats);
+}
+
+TEST(RadixSortTest, KeyExtractorIsStable) {
+    std::mt19937 gen(3);
+    std::vector<Event> events(4000);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        events[i].timestamp = gen() % 50;
+        events[i].payload = std::to_string(i) + std::string(20, 'x');
+    }
+    Deque<Event> deque = fromBothEnds(events);
+    deque.radix_sort([](const Event &event) { return event.timestamp; });
+    std::stable_sort(events.begin(), events.end(), [](const Event &a, const Event &b) {
+        return a.timestamp < b.timestamp;
+    });
+    ASSERT_EQ(deque.size(), events.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        ASSERT_EQ(deque[i].timestamp, events[i].timestamp);
+        ASSERT_EQ(deque[i].payload, events[i].payload);
+    }
+    deque.push_back(Event{7, "tail"});
+    deque.push_front(Event{7, "head"});
+    ASSERT_EQ(deque.back().payload, "tail");
+    ASSERT_EQ(deque.front().payload, "head");
+}
+
+class RadixSortTimeTest : public testing::TestWithParam<std::size_t> {
+};
+
+TEST_P(RadixSortTimeTest, TimeMeasurement) {
+    const std::size_t n = GetParam();
+    std::mt19937_64 gen(4);
+    Deque<std::uint64_t> a, b;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t timestamp = 1700000000000000000ull + gen() % 100000000000ull;
+        a.push_back(timestamp);
+        b.push_back(timestamp);
+    }
+
+    MEASURE_TIME_BEGIN(stdMs);
+    std::sort(a.begin(), a.end());
+    MEASURE_TIME_END(stdMs);
+
+    MEASURE_TIME_BEGIN(radixMs);
+    b.radix_sort();
+    MEASURE_TIME_END(radixMs);
+
+    ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+    std::cout   << "Elements: " << n << std::endl
+                << "std::sort time: " << stdMs << " ms." << std::endl
+                << "radix_sort time: " << radixMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(stdMs, "std::sort", n);
+    MEASURE_PERF_REPORT(radixMs, "radix_sort", n);
+}
+
+INSTANTIATE_TEST_CASE_P(RadixSortTimeTest,
+                        RadixSortTimeTest,
+                        testing::Values(1000, 100000, 1000000, 10000000));
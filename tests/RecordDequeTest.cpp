@@ -0,0 +1,130 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <RecordDeque.h>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+std::string makeRecord(std::size_t n, int seed) {
+    std::string ans(n, '\0');
+    for (std::size_t i = 0; i < n; ++i) {
+        ans[i] = static_cast<char>(seed + i);
+    }
+    return ans;
+}
+
+}
+
+TEST(RecordDequeTest, MatchesStringQueue) {
+    RecordDeque records;
+    std::deque<std::string> expected;
+    std::mt19937 gen(9);
+    for (int i = 0; i < 20000; ++i) {
+        if (expected.empty() || gen() % 5 < 3) {
+            std::size_t n = gen() % 10 == 0 ? gen() % 5000 : gen() % 100;
+            expected.push_back(makeRecord(n, i));
+            records.push_back(expected.back());
+        } else {
+            ASSERT_EQ(records.front_record().str(), expected.front());
+            records.pop_front();
+            expected.pop_front();
+        }
+        ASSERT_EQ(records.size(), expected.size());
+    }
+    auto it = records.begin();
+    for (const std::string &record : expected) {
+        ASSERT_TRUE(it != records.end());
+        ASSERT_EQ((*it).size(), record.size());
+        ASSERT_EQ((*it).str(), record);
+        ++it;
+    }
+    ASSERT_TRUE(it == records.end());
+    records.clear();
+    ASSERT_TRUE(records.empty());
+    ASSERT_THROW(records.pop_front(), std::runtime_error);
+}
+
+TEST(RecordDequeTest, SpanningRecords) {
+    RecordDeque records;
+    records.push_back(std::string());
+    records.push_back(makeRecord(10, 1));
+    records.push_back(makeRecord(3000, 2));
+    ASSERT_EQ(records.bytes_size(), 3 * RecordDeque::HEADER_SIZE + 3010);
+
+    ASSERT_TRUE(records.front_record().empty());
+    records.pop_front();
+    RecordDeque::Record small = records.front_record();
+    ASSERT_NE(small.data(), nullptr);
+    ASSERT_EQ(std::string(small.data(), small.size()), makeRecord(10, 1));
+    records.pop_front();
+    RecordDeque::Record big = records.front_record();
+    ASSERT_EQ(big.data(), nullptr);
+    std::size_t total = 0, segments = 0;
+    for (auto segment : big.segments()) {
+        total += segment.size();
+        ++segments;
+    }
+    ASSERT_EQ(total, 3000);
+    ASSERT_GE(segments, 3);
+    ASSERT_EQ(big.str(), makeRecord(3000, 2));
+}
+
+TEST(RecordDequeTimeTest, TimeMeasurement) {
+    const std::size_t n = 1000000;
+    std::mt19937 gen(10);
+    std::vector<std::size_t> sizes(n);
+    for (auto &size : sizes) {
+        size = 16 + gen() % 240;
+    }
+    std::string payload = makeRecord(256, 0);
+    std::size_t vectorBytes = 0, recordBytes = 0;
+
+    MEASURE_TIME_BEGIN(vectorMs);
+    {
+        Deque<std::vector<char>> queue;
+        for (std::size_t i = 0; i < n; ++i) {
+            queue.push_back(std::vector<char>(payload.begin(), payload.begin() + sizes[i]));
+        }
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            vectorBytes += it->size() + static_cast<unsigned char>(it->back());
+        }
+        while (!queue.empty()) {
+            queue.pop_front();
+        }
+    }
+    MEASURE_TIME_END(vectorMs);
+
+    MEASURE_TIME_BEGIN(recordMs);
+    {
+        RecordDeque queue;
+        for (std::size_t i = 0; i < n; ++i) {
+            queue.push_back(payload.data(), sizes[i]);
+        }
+        for (auto record : queue) {
+            char last = 0;
+            auto segments = record.segments();
+            for (auto segment : segments) {
+                last = segment.data()[segment.size() - 1];
+            }
+            recordBytes += record.size() + static_cast<unsigned char>(last);
+        }
+        while (!queue.empty()) {
+            queue.pop_front();
+        }
+    }
+    MEASURE_TIME_END(recordMs);
+
+    ASSERT_EQ(vectorBytes, recordBytes);
+    std::cout   << "Deque<std::vector<char>> time: " << vectorMs << " ms." << std::endl
+                << "RecordDeque time: " << recordMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(vectorMs, "Deque<std::vector<char>>", n);
+    MEASURE_PERF_REPORT(recordMs, "RecordDeque", n);
+}
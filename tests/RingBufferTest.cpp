@@ -0,0 +1,118 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <RingBuffer.h>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include "Measure.h"
+
+TEST(RingBufferTest, BulkPushPop) {
+    RingBuffer<int> ring(10);
+    std::vector<int> data(15);
+    std::iota(data.begin(), data.end(), 0);
+
+    ASSERT_EQ(ring.push_back_n(data.data(), 7), 7);
+    std::vector<int> out(10);
+    ASSERT_EQ(ring.pop_front_n(out.data(), 5), 5);
+    ASSERT_EQ(out[4], 4);
+
+    // Wraps around the end of the array and stops when full.
+    ASSERT_EQ(ring.push_back_n(data.data() + 7, 8), 8);
+    ASSERT_TRUE(ring.full());
+    ASSERT_EQ(ring.push_back_n(data.data(), 3), 0);
+    ASSERT_EQ(ring.array_one().second + ring.array_two().second, 10);
+    ASSERT_EQ(ring.array_one().first, &ring[0]);
+    ASSERT_EQ(ring.array_two().first, &ring[ring.array_one().second]);
+
+    ASSERT_EQ(ring.peek(out.data(), 10), 10);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(out[i], i + 5);
+        ASSERT_EQ(ring[i], i + 5);
+    }
+    ASSERT_EQ(ring.size(), 10);
+
+    ASSERT_EQ(ring.pop_front_n(out.data(), 20), 10);
+    ASSERT_TRUE(ring.empty());
+    ASSERT_EQ(out[9], 14);
+}
+
+TEST(RingBufferTest, Linearize) {
+    RingBuffer<int> ring(8);
+    for (int i = 0; i < 6; ++i) {
+        ring.push_back(i);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ring.pop_front();
+    }
+    for (int i = 6; i < 11; ++i) {
+        ring.push_back(i);
+    }
+    ASSERT_NE(ring.array_two().second, 0);
+
+    int *data = ring.linearize();
+    ASSERT_EQ(ring.array_one().second, 7);
+    ASSERT_EQ(ring.array_two().second, 0);
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_EQ(data[i], i + 4);
+    }
+
+    ring.push_back(11);
+    ASSERT_TRUE(ring.full());
+    ASSERT_EQ(ring.back(), 11);
+    ASSERT_EQ(ring.linearize()[7], 11);
+}
+
+TEST(RingBufferTest, ChunkTimeMeasurement) {
+    const std::size_t chunk = 1500, total = 100000000;
+    RingBuffer<char> ring(1 << 16);
+    std::vector<char> in(chunk, 'x'), out(chunk);
+    long long checksum = 0;
+
+    MEASURE_TIME_BEGIN(elementMs);
+    for (std::size_t done = 0; done < total; done += chunk) {
+        for (std::size_t i = 0; i < chunk; ++i) {
+            ring.push_back(in[i]);
+        }
+        for (std::size_t i = 0; i < chunk; ++i) {
+            out[i] = ring.front();
+            ring.pop_front();
+        }
+        checksum += out[chunk - 1];
+    }
+    MEASURE_TIME_END(elementMs);
+
+    MEASURE_TIME_BEGIN(bulkMs);
+    for (std::size_t done = 0; done < total; done += chunk) {
+        ring.push_back_n(in.data(), chunk);
+        ring.pop_front_n(out.data(), chunk);
+        checksum -= out[chunk - 1];
+    }
+    MEASURE_TIME_END(bulkMs);
+
+    ASSERT_EQ(checksum, 0);
+    std::cout   << "Per-element time: " << elementMs << " ms." << std::endl
+                << "Bulk time: " << bulkMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(elementMs, "Per-element", total);
+    MEASURE_PERF_REPORT(bulkMs, "Bulk", total);
+}
+
+TEST(RingBufferTest, OverwriteOldest) {
+    RingBuffer<int> ring(4);
+    for (int i = 0; i < 10; ++i) {
+        ring.push_back_overwrite(i);
+        ASSERT_EQ(ring.back(), i);
+    }
+    ASSERT_TRUE(ring.full());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(ring[i], i + 6);
+    }
+    ring.pop_front();
+    ring.push_back_overwrite(10);
+    ASSERT_EQ(ring.front(), 7);
+    ring.push_back_overwrite(11);
+    ASSERT_EQ(ring.front(), 8);
+    ASSERT_EQ(ring.back(), 11);
+}
@@ -0,0 +1,89 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <Deque.h>
+#include <vector>
+#include <sys/uio.h>
+#include <unistd.h>
+
+TEST(SegmentTest, Empty) {
+    Deque<int> d;
+    ASSERT_TRUE(d.segments().empty());
+    ASSERT_EQ(d.segments().size(), 0);
+    ASSERT_EQ(d.segments().begin(), d.segments().end());
+}
+
+TEST(SegmentTest, CoversAllElements) {
+    Deque<int> d;
+    for (int i = 0; i < 1000; ++i) {
+        d.push_back(i);
+        d.push_front(-i);
+    }
+
+    std::vector<int> flat;
+    std::size_t count = 0;
+    for (auto segment : d.segments()) {
+        ASSERT_FALSE(segment.empty());
+        flat.insert(flat.end(), segment.begin(), segment.end());
+        ++count;
+    }
+    ASSERT_EQ(count, d.getBlocksCount());
+    ASSERT_EQ(count, d.segments().size());
+    ASSERT_TRUE(std::equal(flat.begin(), flat.end(), d.begin()));
+    ASSERT_EQ(flat.size(), d.size());
+}
+
+TEST(SegmentTest, SubRange) {
+    Deque<int> d;
+    for (int i = 0; i < 5000; ++i) {
+        d.push_back(i);
+    }
+    const Deque<int> &cd = d;
+
+    auto range = cd.segments(cd.begin() + 100, cd.end() - 300);
+    std::vector<int> flat;
+    for (auto segment : range) {
+        flat.insert(flat.end(), segment.begin(), segment.end());
+    }
+    ASSERT_EQ(flat.size(), 4600);
+    ASSERT_EQ(flat.front(), 100);
+    ASSERT_EQ(flat.back(), 4699);
+    ASSERT_TRUE(std::equal(flat.begin(), flat.end(), cd.begin() + 100));
+
+    for (auto segment : d.segments(d.begin() + 10, d.begin() + 20)) {
+        for (int &x : segment) {
+            x = -1;
+        }
+    }
+    ASSERT_EQ(d[9], 9);
+    ASSERT_EQ(d[10], -1);
+    ASSERT_EQ(d[19], -1);
+    ASSERT_EQ(d[20], 20);
+
+    Deque<int> other;
+    ASSERT_THROW(d.segments(other.begin(), other.end()), std::runtime_error);
+}
+
+TEST(SegmentTest, Writev) {
+    Deque<char> d;
+    for (int i = 0; i < 3000; ++i) {
+        d.push_back('a' + i % 26);
+    }
+
+    std::vector<iovec> iov;
+    for (auto segment : d.segments()) {
+        iov.push_back({segment.data(), segment.size()});
+    }
+    ASSERT_EQ(iov.size(), d.segments().size());
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(writev(fds[1], iov.data(), iov.size()), 3000);
+    std::vector<char> buf(3000);
+    ASSERT_EQ(read(fds[0], buf.data(), buf.size()), 3000);
+    close(fds[0]);
+    close(fds[1]);
+    ASSERT_TRUE(std::equal(buf.begin(), buf.end(), d.begin()));
+}
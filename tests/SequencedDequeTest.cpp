@@ -0,0 +1,84 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SequencedDeque.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+TEST(SequencedDequeTest, AckThrough) {
+    SequencedDeque<int> window(1000);
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(window.push_back(i), 1000u + i);
+    }
+    ASSERT_EQ(window.at_seq(1000), 0);
+    ASSERT_EQ(window.at_seq(5999), 4999);
+    ASSERT_FALSE(window.contains_seq(999));
+    ASSERT_FALSE(window.contains_seq(6000));
+    ASSERT_THROW(window.at_seq(6000), std::runtime_error);
+
+    ASSERT_EQ(window.ack_through(3499), 2500);
+    ASSERT_EQ(window.front_seq(), 3500);
+    ASSERT_EQ(window.front(), 2500);
+    ASSERT_FALSE(window.contains_seq(3499));
+    ASSERT_EQ(window.at_seq(4242), 3242);
+    ASSERT_EQ(window.ack_through(3000), 0);
+    ASSERT_EQ(window.ack_through(3499), 0);
+    ASSERT_EQ(window.front_seq(), 3500);
+    ASSERT_THROW(window.ack_through(6000), std::runtime_error);
+
+    window.pop_front();
+    ASSERT_EQ(window.front_seq(), 3501);
+    window.pop_back();
+    ASSERT_EQ(window.next_seq(), 5999);
+    ASSERT_EQ(window.ack_through(5998), 2498);
+    ASSERT_TRUE(window.empty());
+    ASSERT_EQ(window.push_back(7), 5999);
+}
+
+TEST(SequencedDequeTest, Iterators) {
+    SequencedDeque<std::string> window(10);
+    for (int i = 0; i < 300; ++i) {
+        window.push_back(std::to_string(i));
+    }
+    window.ack_through(109);
+    std::uint64_t expected = 110;
+    for (auto it = window.begin(); it != window.end(); ++it) {
+        ASSERT_EQ(it.seq(), expected);
+        ASSERT_EQ(*it, std::to_string(expected - 10));
+        ++expected;
+    }
+    ASSERT_EQ(expected, window.next_seq());
+
+    auto it = window.find_seq(200);
+    ASSERT_EQ(*it, "190");
+    ASSERT_EQ((it + 5).seq(), 205);
+    ASSERT_EQ((it + 5)->size(), 3);
+    ASSERT_EQ(window.end() - it, 110);
+    ASSERT_TRUE(it < it + 1);
+    ASSERT_TRUE(it + 1 > it);
+    ASSERT_TRUE(it <= it);
+    ASSERT_TRUE(it >= it);
+    ASSERT_FALSE(it > window.end());
+    *it = "changed";
+    const SequencedDeque<std::string> &constWindow = window;
+    ASSERT_EQ(*constWindow.find_seq(200), "changed");
+    ASSERT_EQ(constWindow.begin().seq(), 110);
+}
+
+TEST(SequencedDequeTest, Wraparound) {
+    const std::uint64_t start = std::numeric_limits<std::uint64_t>::max() - 10;
+    SequencedDeque<int> window(start);
+    for (int i = 0; i < 100; ++i) {
+        window.push_back(i);
+    }
+    ASSERT_EQ(window.next_seq(), 89);
+    ASSERT_TRUE(window.contains_seq(start + 20));
+    ASSERT_EQ(window.at_seq(5), 16);
+    ASSERT_EQ(window.ack_through(3), 15);
+    ASSERT_EQ(window.front_seq(), 4);
+    ASSERT_FALSE(window.contains_seq(start));
+    ASSERT_EQ(window.ack_through(start), 0);
+}
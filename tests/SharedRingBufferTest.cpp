@@ -0,0 +1,222 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SharedRingBuffer.h>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Measure.h"
+
+namespace {
+
+struct Frame {
+    std::uint64_t seq;
+    char payload[56];
+};
+
+std::string region_name(const char *tag) {
+    return std::string("/deque_") + tag + "_" + std::to_string(getpid());
+}
+
+bool write_all(int fd, const void *data, std::size_t n) {
+    const char *ptr = static_cast<const char *>(data);
+    while (n != 0) {
+        ssize_t written = write(fd, ptr, n);
+        if (written <= 0) {
+            return false;
+        }
+        ptr += written;
+        n -= written;
+    }
+    return true;
+}
+
+bool read_all(int fd, void *data, std::size_t n) {
+    char *ptr = static_cast<char *>(data);
+    while (n != 0) {
+        ssize_t got = read(fd, ptr, n);
+        if (got <= 0) {
+            return false;
+        }
+        ptr += got;
+        n -= got;
+    }
+    return true;
+}
+
+}
+
+TEST(SharedRingBufferTest, NamedRegion) {
+    std::string name = region_name("named");
+    SharedRingBuffer<int>::unlink(name);
+    auto producer = SharedRingBuffer<int>::create(name, 1000);
+    auto consumer = SharedRingBuffer<int>::open(name);
+    ASSERT_EQ(producer.capacity(), 1024);
+    ASSERT_EQ(consumer.capacity(), 1024);
+    ASSERT_THROW(SharedRingBuffer<int>::create(name, 16), std::runtime_error);
+    ASSERT_THROW(SharedRingBuffer<std::uint64_t>::open(name), std::runtime_error);
+
+    std::deque<int> expected;
+    std::mt19937 gen(3);
+    std::vector<int> buffer(1500);
+    int next = 0;
+    for (int round = 0; round < 2000; ++round) {
+        std::size_t n = gen() % buffer.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer[i] = next + i;
+        }
+        std::size_t pushed = producer.push_back_n(buffer.data(), n);
+        ASSERT_EQ(pushed, std::min(n, 1024 - expected.size()));
+        for (std::size_t i = 0; i < pushed; ++i) {
+            expected.push_back(next++);
+        }
+        ASSERT_EQ(consumer.size(), expected.size());
+
+        std::size_t popped = consumer.pop_front_n(buffer.data(), gen() % buffer.size());
+        for (std::size_t i = 0; i < popped; ++i) {
+            ASSERT_EQ(buffer[i], expected.front());
+            expected.pop_front();
+        }
+    }
+    int value;
+    while (consumer.try_pop(value)) {
+        ASSERT_EQ(value, expected.front());
+        expected.pop_front();
+    }
+    ASSERT_TRUE(expected.empty());
+    ASSERT_TRUE(producer.empty());
+
+    SharedRingBuffer<int>::unlink(name);
+    ASSERT_THROW(SharedRingBuffer<int>::open(name), std::runtime_error);
+}
+
+TEST(SharedRingBufferTest, TwoProcesses) {
+    const std::uint64_t n = 1000000;
+    auto data = SharedRingBuffer<std::uint64_t>::anonymous(256);
+    auto result = SharedRingBuffer<std::uint64_t>::anonymous(1);
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        std::uint64_t sum = 0, expected = 0, value;
+        bool ordered = true;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            data.pop(value);
+            ordered = ordered && value == expected++;
+            sum += value;
+        }
+        result.push(ordered ? sum : 0);
+        _exit(0);
+    }
+    for (std::uint64_t i = 0; i < n; ++i) {
+        data.push(i);
+    }
+    std::uint64_t sum;
+    result.pop(sum);
+    int status;
+    waitpid(child, &status, 0);
+    ASSERT_EQ(sum, n * (n - 1) / 2);
+    ASSERT_TRUE(WIFEXITED(status));
+}
+
+TEST(SharedRingBufferTimeTest, TimeMeasurement) {
+    const std::size_t roundTrips = 50000, streamed = 2000000;
+
+    // Child echoes every frame back; the parent measures round trips and then
+    // one-way streaming of the same frames.
+    auto ring_run = [&](double &pingPongMs, double &streamMs) {
+        auto ping = SharedRingBuffer<Frame>::anonymous(1024);
+        auto pong = SharedRingBuffer<Frame>::anonymous(1024);
+        pid_t child = fork();
+        if (child == 0) {
+            Frame frame;
+            for (std::size_t i = 0; i < roundTrips; ++i) {
+                ping.pop(frame);
+                pong.push(frame);
+            }
+            for (std::size_t i = 0; i < streamed; ++i) {
+                ping.pop(frame);
+            }
+            pong.push(frame);
+            _exit(0);
+        }
+        Frame frame = Frame();
+        MEASURE_TIME_BEGIN(pingPong);
+        for (std::size_t i = 0; i < roundTrips; ++i) {
+            frame.seq = i;
+            ping.push(frame);
+            pong.pop(frame);
+        }
+        MEASURE_TIME_END(pingPong);
+        MEASURE_TIME_BEGIN(stream);
+        for (std::size_t i = 0; i < streamed; ++i) {
+            frame.seq = i;
+            ping.push(frame);
+        }
+        pong.pop(frame);
+        MEASURE_TIME_END(stream);
+        MEASURE_PERF_REPORT(pingPong, "Shared ring round trip", roundTrips);
+        MEASURE_PERF_REPORT(stream, "Shared ring stream", streamed);
+        waitpid(child, nullptr, 0);
+        pingPongMs = pingPong;
+        streamMs = stream;
+    };
+
+    auto socket_run = [&](double &pingPongMs, double &streamMs) {
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        pid_t child = fork();
+        if (child == 0) {
+            close(fds[0]);
+            Frame frame;
+            for (std::size_t i = 0; i < roundTrips; ++i) {
+                read_all(fds[1], &frame, sizeof(frame));
+                write_all(fds[1], &frame, sizeof(frame));
+            }
+            for (std::size_t i = 0; i < streamed; ++i) {
+                read_all(fds[1], &frame, sizeof(frame));
+            }
+            write_all(fds[1], &frame, sizeof(frame));
+            _exit(0);
+        }
+        close(fds[1]);
+        Frame frame = Frame();
+        MEASURE_TIME_BEGIN(pingPong);
+        for (std::size_t i = 0; i < roundTrips; ++i) {
+            frame.seq = i;
+            write_all(fds[0], &frame, sizeof(frame));
+            read_all(fds[0], &frame, sizeof(frame));
+        }
+        MEASURE_TIME_END(pingPong);
+        MEASURE_TIME_BEGIN(stream);
+        for (std::size_t i = 0; i < streamed; ++i) {
+            frame.seq = i;
+            write_all(fds[0], &frame, sizeof(frame));
+        }
+        read_all(fds[0], &frame, sizeof(frame));
+        MEASURE_TIME_END(stream);
+        MEASURE_PERF_REPORT(pingPong, "Unix socket round trip", roundTrips);
+        MEASURE_PERF_REPORT(stream, "Unix socket stream", streamed);
+        waitpid(child, nullptr, 0);
+        close(fds[0]);
+        pingPongMs = pingPong;
+        streamMs = stream;
+    };
+
+    double ringPingPongMs, ringStreamMs, socketPingPongMs, socketStreamMs;
+    ring_run(ringPingPongMs, ringStreamMs);
+    socket_run(socketPingPongMs, socketStreamMs);
+
+    std::cout   << "Frame size: " << sizeof(Frame) << " bytes" << std::endl
+                << "Shared ring round trip: " << ringPingPongMs * 1000 / roundTrips << " us." << std::endl
+                << "Unix socket round trip: " << socketPingPongMs * 1000 / roundTrips << " us." << std::endl
+                << "Shared ring stream of " << streamed << " frames: " << ringStreamMs << " ms." << std::endl
+                << "Unix socket stream of " << streamed << " frames: " << socketStreamMs << " ms." << std::endl;
+}
@@ -0,0 +1,171 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SlidingWindow.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include "Measure.h"
+
+namespace {
+
+// Composition of affine maps x -> a * x + b modulo a prime: associative but
+// not commutative, so any ordering mistake in the aggregator shows up.
+struct Affine {
+    std::uint64_t a, b;
+
+    bool operator ==(const Affine &other) const {
+        return a == other.a && b == other.b;
+    }
+};
+
+struct AffineMonoid {
+    static const std::uint64_t MOD = 1000000007;
+
+    Affine identity() const {
+        return Affine{1, 0};
+    }
+
+    Affine operator ()(const Affine &f, const Affine &g) const {
+        return Affine{g.a * f.a % MOD, (g.a * f.b + g.b) % MOD};
+    }
+};
+
+unsigned nextRandom(unsigned &x) {
+    x = x * 1103515245 + 12345;
+    return x >> 16;
+}
+
+}
+
+TEST(SlidingWindowTest, MonotonicMinMax) {
+    MonotonicWindow<int> minWindow;
+    MonotonicWindow<int, std::greater<int>> maxWindow;
+    std::deque<int> window;
+    unsigned x = 7;
+    for (int i = 0; i < 100000; ++i) {
+        if (window.empty() || nextRandom(x) % 3 != 0) {
+            int value = nextRandom(x) % 1000;
+            minWindow.push(value);
+            maxWindow.push(value);
+            window.push_back(value);
+        } else {
+            minWindow.pop();
+            maxWindow.pop();
+            window.pop_front();
+        }
+        ASSERT_EQ(minWindow.size(), window.size());
+        if (!window.empty()) {
+            ASSERT_EQ(minWindow.top(), *std::min_element(window.begin(), window.end()));
+            ASSERT_EQ(maxWindow.top(), *std::max_element(window.begin(), window.end()));
+        }
+    }
+    ASSERT_THROW(MonotonicWindow<int>().pop(), std::runtime_error);
+}
+
+TEST(SlidingWindowTest, NonCommutativeAggregation) {
+    SlidingWindowAggregator<Affine, AffineMonoid> aggregator;
+    std::deque<Affine> window;
+    AffineMonoid monoid;
+    unsigned x = 13;
+    for (int i = 0; i < 20000; ++i) {
+        // Mostly balanced traffic with bursts in both directions.
+        unsigned bias = (i / 2000) % 2 == 0 ? 3 : 6;
+        if (window.empty() || nextRandom(x) % 10 < bias) {
+            Affine f{nextRandom(x) % 1000 + 1, nextRandom(x) % 1000};
+            aggregator.push(f);
+            window.push_back(f);
+        } else {
+            ASSERT_EQ(aggregator.front(), window.front());
+            aggregator.pop();
+            window.pop_front();
+        }
+        Affine expected = monoid.identity();
+        for (const Affine &f : window) {
+            expected = monoid(expected, f);
+        }
+        ASSERT_EQ(aggregator.size(), window.size());
+        ASSERT_EQ(aggregator.query(), expected);
+    }
+}
+
+TEST(SlidingWindowTest, MinMaxMonoids) {
+    SlidingWindowAggregator<int, MinMonoid<int>> minAggregator;
+    SlidingWindowAggregator<int, MaxMonoid<int>> maxAggregator;
+    ASSERT_EQ(minAggregator.query(), std::numeric_limits<int>::max());
+    for (int i = 0; i < 100; ++i) {
+        minAggregator.push(i % 17);
+        maxAggregator.push(i % 17);
+        if (i >= 10) {
+            minAggregator.pop();
+            maxAggregator.pop();
+        }
+    }
+    ASSERT_EQ(minAggregator.size(), 10);
+    ASSERT_EQ(minAggregator.query(), 5);
+    ASSERT_EQ(maxAggregator.query(), 14);
+}
+
+class SlidingWindowTimeTest : public testing::TestWithParam<std::size_t> {
+};
+
+TEST_P(SlidingWindowTimeTest, TimeMeasurement) {
+    const std::size_t n = 2000000, window = GetParam();
+    std::vector<int> stream(n);
+    unsigned x = 1;
+    for (auto &value : stream) {
+        value = nextRandom(x) % 100000;
+    }
+    long long naiveChecksum = 0, checksum = 0;
+
+    MEASURE_TIME_BEGIN(naiveMs);
+    {
+        Deque<int> values;
+        for (std::size_t i = 0; i < n; ++i) {
+            values.push_back(stream[i]);
+            if (values.size() > window) {
+                values.pop_front();
+            }
+            long long sum = 0;
+            int minimum = values.front();
+            for (auto segment : values.segments()) {
+                for (int value : segment) {
+                    sum += value;
+                    minimum = std::min(minimum, value);
+                }
+            }
+            naiveChecksum += sum + minimum;
+        }
+    }
+    MEASURE_TIME_END(naiveMs);
+
+    MEASURE_TIME_BEGIN(windowMs);
+    {
+        SlidingWindowAggregator<long long> sums;
+        MonotonicWindow<int> minimums;
+        for (std::size_t i = 0; i < n; ++i) {
+            sums.push(stream[i]);
+            minimums.push(stream[i]);
+            if (sums.size() > window) {
+                sums.pop();
+                minimums.pop();
+            }
+            checksum += sums.query() + minimums.top();
+        }
+    }
+    MEASURE_TIME_END(windowMs);
+
+    ASSERT_EQ(naiveChecksum, checksum);
+    std::cout   << "Window size: " << window << std::endl
+                << "Naive recomputation time: " << naiveMs << " ms." << std::endl
+                << "Sliding window time: " << windowMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(naiveMs, "Naive recomputation", n);
+    MEASURE_PERF_REPORT(windowMs, "Sliding window", n);
+}
+
+INSTANTIATE_TEST_CASE_P(SlidingWindowTimeTest,
+                        SlidingWindowTimeTest,
+                        testing::Values(10, 100, 1000));
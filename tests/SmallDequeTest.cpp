@@ -0,0 +1,179 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SmallDeque.h>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <stack>
+
+static std::atomic<std::size_t> allocationsCount(0);
+
+void *operator new(std::size_t size) {
+    ++allocationsCount;
+    if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+struct ThrowingCopy {
+    static int alive;
+    static int copiesLeft;
+    int value;
+
+    ThrowingCopy(int value = 0) : value(value) {
+        ++alive;
+    }
+
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+        if (copiesLeft-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        ++alive;
+    }
+
+    ~ThrowingCopy() {
+        --alive;
+    }
+};
+
+int ThrowingCopy::alive = 0;
+int ThrowingCopy::copiesLeft = -1;
+
+}
+
+TEST(SmallDequeTest, EmptyDequeDoesNotAllocate) {
+    std::size_t before = allocationsCount;
+    {
+        Deque<int> d;
+        ASSERT_TRUE(d.empty());
+        ASSERT_EQ(d.size(), 0);
+    }
+    ASSERT_EQ(allocationsCount, before);
+}
+
+TEST(SmallDequeTest, InlineDoesNotAllocate) {
+    std::size_t before = allocationsCount;
+    {
+        SmallDeque<int, 8> d;
+        for (int i = 0; i < 4; ++i) {
+            d.push_back(i);
+            d.push_front(-i);
+        }
+        ASSERT_TRUE(d.is_inline());
+        ASSERT_EQ(d.size(), 8);
+        ASSERT_EQ(d.front(), -3);
+        ASSERT_EQ(d.back(), 3);
+        d.pop_front();
+        d.pop_back();
+        ASSERT_EQ(d.size(), 6);
+    }
+    ASSERT_EQ(allocationsCount, before);
+}
+
+TEST(SmallDequeTest, SpillAndReturnInline) {
+    SmallDeque<std::string, 4> d;
+    std::deque<std::string> expected;
+    for (int i = 0; i < 100; ++i) {
+        d.push_back(std::to_string(i));
+        expected.push_back(std::to_string(i));
+        if (i % 3 == 0) {
+            d.push_front(std::to_string(-i));
+            expected.push_front(std::to_string(-i));
+        }
+    }
+    ASSERT_FALSE(d.is_inline());
+    ASSERT_EQ(d.size(), expected.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), d.begin()));
+
+    SmallDeque<std::string, 4> copy(d);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), copy.begin()));
+
+    while (!expected.empty()) {
+        ASSERT_EQ(d.front(), expected.front());
+        d.pop_front();
+        expected.pop_front();
+    }
+    ASSERT_TRUE(d.empty());
+    ASSERT_TRUE(d.is_inline());
+    ASSERT_THROW(d.pop_back(), std::runtime_error);
+
+    d.push_front("a");
+    d.push_back("b");
+    ASSERT_TRUE(d.is_inline());
+    ASSERT_EQ(d[0], "a");
+    ASSERT_EQ(d[1], "b");
+
+    copy = d;
+    ASSERT_EQ(copy.size(), 2);
+    ASSERT_EQ(copy.back(), "b");
+}
+
+TEST(SmallDequeTest, PushOwnElementWhileSpilling) {
+    SmallDeque<std::string, 4> d;
+    for (int i = 0; i < 4; ++i) {
+        d.push_back(std::string(100, 'a' + i));
+    }
+    d.push_back(d.back());
+    ASSERT_FALSE(d.is_inline());
+    ASSERT_EQ(d.back(), std::string(100, 'd'));
+
+    SmallDeque<std::string, 4> e;
+    for (int i = 0; i < 4; ++i) {
+        e.push_back(std::string(100, 'a' + i));
+    }
+    e.push_front(e.back());
+    ASSERT_EQ(e.front(), std::string(100, 'd'));
+    ASSERT_EQ(e[4], std::string(100, 'd'));
+}
+
+TEST(SmallDequeTest, ThrowingCopyWhileSpilling) {
+    {
+        SmallDeque<ThrowingCopy, 4> d;
+        for (int i = 0; i < 4; ++i) {
+            d.push_back(ThrowingCopy(i));
+        }
+        ThrowingCopy extra(4);
+        ThrowingCopy::copiesLeft = 2;
+        ASSERT_THROW(d.push_back(extra), std::runtime_error);
+        ThrowingCopy::copiesLeft = -1;
+        ASSERT_TRUE(d.is_inline());
+        ASSERT_EQ(d.size(), 4);
+        ASSERT_EQ(ThrowingCopy::alive, 5);
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_EQ(d[i].value, i);
+        }
+        d.push_back(extra);
+        ASSERT_FALSE(d.is_inline());
+        ASSERT_EQ(d.back().value, 4);
+    }
+    ASSERT_EQ(ThrowingCopy::alive, 0);
+}
+
+TEST(SmallDequeTest, StackAdaptor) {
+    std::stack<int, SmallDeque<int, 16>> s;
+    for (int i = 0; i < 100; ++i) {
+        s.push(i);
+    }
+    for (int i = 99; i >= 0; --i) {
+        ASSERT_EQ(s.top(), i);
+        s.pop();
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SoaDeque.h>
+#include <DequeAlgorithms.h>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include "Measure.h"
+
+namespace {
+
+struct Tick {
+    std::int64_t timestamp;
+    float price;
+    std::int32_t qty;
+    std::uint8_t flags;
+};
+
+typedef SoaDeque<std::int64_t, float, std::int32_t, std::uint8_t> TickDeque;
+
+}
+
+TEST(SoaDequeTest, Rows) {
+    TickDeque ticks;
+    for (int i = 0; i < 3000; ++i) {
+        ticks.push_back(i, i * 0.5f, i % 100, static_cast<std::uint8_t>(i % 2));
+    }
+    ticks.push_front(-1, -0.5f, 7, 1);
+    ASSERT_EQ(ticks.size(), 3001);
+    ASSERT_EQ(std::get<0>(ticks.front()), -1);
+    ASSERT_EQ(std::get<1>(ticks[11]), 5.0f);
+    ASSERT_EQ(std::get<2>(ticks.back()), 99);
+
+    std::get<2>(ticks[11]) = 1000;
+    TickDeque::row_reference row = ticks[12];
+    std::get<1>(row) = 42.0f;
+    const TickDeque &constTicks = ticks;
+    ASSERT_EQ(std::get<2>(constTicks[11]), 1000);
+    ASSERT_EQ(constTicks.column<1>()[12], 42.0f);
+    ticks.field<3>(12) = 5;
+    ASSERT_EQ(constTicks.field<3>(12), 5);
+
+    ticks.pop_front();
+    ticks.pop_back();
+    ASSERT_EQ(ticks.size(), 2999);
+    ASSERT_EQ(std::get<0>(ticks.front()), 0);
+    ASSERT_EQ(ticks.column<0>().size(), ticks.column<3>().size());
+}
+
+TEST(SoaDequeTest, ColumnSegments) {
+    SoaDeque<std::int32_t, std::string> rows;
+    for (int i = 0; i < 1000; ++i) {
+        rows.push_back(i, std::to_string(i));
+    }
+    std::int64_t sum = 0;
+    std::size_t count = 0;
+    for (auto segment : rows.column_segments<0>()) {
+        for (std::int32_t value : segment) {
+            sum += value;
+            ++count;
+        }
+    }
+    ASSERT_EQ(count, 1000);
+    ASSERT_EQ(sum, 999 * 1000 / 2);
+    ASSERT_EQ(deque_sum(rows.column<0>()), 999 * 1000 / 2);
+    ASSERT_EQ(std::get<1>(rows[500]), "500");
+    while (!rows.empty()) {
+        rows.pop_back();
+    }
+    ASSERT_THROW(rows.pop_front(), std::runtime_error);
+}
+
+TEST(SoaDequeTimeTest, TimeMeasurement) {
+    const std::size_t n = 10000000;
+    Deque<Tick> aos;
+    TickDeque soa;
+    for (std::size_t i = 0; i < n; ++i) {
+        Tick tick{static_cast<std::int64_t>(i), static_cast<float>(i % 1000), static_cast<std::int32_t>(i % 7), 0};
+        aos.push_back(tick);
+        soa.push_back(tick.timestamp, tick.price, tick.qty, tick.flags);
+    }
+    std::int64_t aosSum = 0, soaSum = 0;
+
+    MEASURE_TIME_BEGIN(aosMs);
+    for (auto segment : aos.segments()) {
+        for (const Tick &tick : segment) {
+            aosSum += tick.qty;
+        }
+    }
+    MEASURE_TIME_END(aosMs);
+
+    MEASURE_TIME_BEGIN(soaMs);
+    for (auto segment : soa.column_segments<2>()) {
+        for (std::int32_t qty : segment) {
+            soaSum += qty;
+        }
+    }
+    MEASURE_TIME_END(soaMs);
+
+    ASSERT_EQ(aosSum, soaSum);
+    std::cout   << "Scan of one field over " << n << " records" << std::endl
+                << "Deque<Tick> time: " << aosMs << " ms." << std::endl
+                << "SoaDeque column time: " << soaMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(aosMs, "Deque<Tick>", n);
+    MEASURE_PERF_REPORT(soaMs, "SoaDeque column", n);
+}
@@ -0,0 +1,150 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <SortedDeque.h>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+struct Event {
+    std::uint64_t timestamp;
+    int id;
+};
+
+struct EventTime {
+    std::uint64_t operator ()(const Event &event) const {
+        return event.timestamp;
+    }
+};
+
+}
+
+TEST(SortedDequeTest, PopFrontN) {
+    Deque<int> deque;
+    std::deque<int> expected;
+    for (int i = 0; i < 10000; ++i) {
+        deque.push_back(i);
+        expected.push_back(i);
+        if (i % 3 == 0) {
+            deque.push_front(-i);
+            expected.push_front(-i);
+        }
+    }
+    std::mt19937 gen(5);
+    while (!expected.empty()) {
+        std::size_t n = std::min<std::size_t>(gen() % 700, expected.size());
+        deque.pop_front_n(n);
+        expected.erase(expected.begin(), expected.begin() + n);
+        ASSERT_EQ(deque.size(), expected.size());
+        if (!expected.empty()) {
+            ASSERT_EQ(deque.front(), expected.front());
+            ASSERT_EQ(deque.back(), expected.back());
+            ASSERT_EQ(deque[expected.size() / 2], expected[expected.size() / 2]);
+        }
+        deque.push_back(1);
+        deque.pop_back();
+    }
+    ASSERT_EQ(deque.getBlocksCount(), 0);
+    ASSERT_THROW(deque.pop_front_n(1), std::runtime_error);
+}
+
+TEST(SortedDequeTest, Bounds) {
+    SortedDeque<int> sorted;
+    std::vector<int> values;
+    std::mt19937 gen(6);
+    int value = 0;
+    for (int i = 0; i < 5000; ++i) {
+        value += gen() % 3;
+        sorted.push_back(value);
+        values.push_back(value);
+    }
+    ASSERT_THROW(sorted.push_back(value - 1), std::runtime_error);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int key = values.front() - 1; key <= values.back() + 1; ++key) {
+            ASSERT_EQ(sorted.lower_bound(key) - sorted.begin(),
+                      std::lower_bound(values.begin(), values.end(), key) - values.begin());
+            ASSERT_EQ(sorted.upper_bound(key) - sorted.begin(),
+                      std::upper_bound(values.begin(), values.end(), key) - values.begin());
+        }
+        for (int i = 0; i < 777; ++i) {
+            sorted.pop_front();
+            values.erase(values.begin());
+        }
+        for (int i = 0; i < 100; ++i) {
+            sorted.pop_back();
+            values.pop_back();
+        }
+    }
+}
+
+TEST(SortedDequeTest, ExpireFrontWhile) {
+    SortedDeque<Event, EventTime> events;
+    for (int i = 0; i < 20000; ++i) {
+        events.push_back(Event{static_cast<std::uint64_t>(i / 4), i});
+    }
+    std::size_t removed = events.expire_front_while([](const Event &event) {
+        return event.timestamp < 1000;
+    });
+    ASSERT_EQ(removed, 4000);
+    ASSERT_EQ(events.front().id, 4000);
+    ASSERT_EQ(events.lower_bound(1500)->id, 6000);
+    ASSERT_EQ(events.upper_bound(1500)->id, 6004);
+    ASSERT_EQ(events.lower_bound(999) - events.begin(), 0);
+    ASSERT_TRUE(events.lower_bound(5000) == events.end());
+
+    ASSERT_EQ(events.expire_front_while([](const Event &) { return false; }), 0);
+    ASSERT_EQ(events.expire_front_while([](const Event &) { return true; }), 16000);
+    ASSERT_TRUE(events.empty());
+    events.push_back(Event{1, 1});
+    ASSERT_EQ(events.lower_bound(1)->id, 1);
+}
+
+TEST(SortedDequeTimeTest, TimeMeasurement) {
+    const std::size_t n = 10000000, queries = 1000000;
+    SortedDeque<std::uint64_t> sorted;
+    for (std::size_t i = 0; i < n; ++i) {
+        sorted.push_back(3 * i);
+    }
+    const Deque<std::uint64_t> &deque = sorted.data();
+    std::mt19937_64 gen(7);
+    std::vector<std::uint64_t> keys(queries);
+    for (auto &key : keys) {
+        key = gen() % (3 * n);
+    }
+    std::size_t stdSum = 0, sortedSum = 0;
+
+    MEASURE_TIME_BEGIN(stdMs);
+    for (auto key : keys) {
+        stdSum += std::lower_bound(deque.begin(), deque.end(), key) - deque.begin();
+    }
+    MEASURE_TIME_END(stdMs);
+
+    MEASURE_TIME_BEGIN(sortedMs);
+    for (auto key : keys) {
+        sortedSum += sorted.lower_bound(key) - sorted.begin();
+    }
+    MEASURE_TIME_END(sortedMs);
+
+    MEASURE_TIME_BEGIN(expireMs);
+    for (std::uint64_t cutoff = 0; !sorted.empty(); cutoff += 3000) {
+        sorted.expire_front_while([cutoff](std::uint64_t value) { return value < cutoff; });
+    }
+    MEASURE_TIME_END(expireMs);
+
+    ASSERT_EQ(stdSum, sortedSum);
+    std::cout   << "std::lower_bound time: " << stdMs << " ms." << std::endl
+                << "SortedDeque::lower_bound time: " << sortedMs << " ms." << std::endl
+                << "expire_front_while over " << n << " elements: " << expireMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(stdMs, "std::lower_bound", queries);
+    MEASURE_PERF_REPORT(sortedMs, "SortedDeque::lower_bound", queries);
+    MEASURE_PERF_REPORT(expireMs, "expire_front_while", n);
+}
@@ -0,0 +1,112 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <StaticRingBuffer.h>
+#include <RingBuffer.h>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "Measure.h"
+
+static_assert(StaticRingBuffer<int, 16>::capacity() == 16, "capacity is a compile-time constant");
+static_assert(sizeof(StaticRingBuffer<std::uint32_t, 64>) == 64 * sizeof(std::uint32_t) + 2 * sizeof(std::size_t),
+              "no indirection or allocation");
+static_assert(std::is_trivially_destructible<StaticRingBuffer<int, 8>>::value, "trivial T keeps a trivial destructor");
+static_assert(noexcept(std::declval<StaticRingBuffer<int, 8> &>().push_back(1)), "push_back is noexcept");
+static_assert(!noexcept(std::declval<StaticRingBuffer<std::string, 8> &>().push_back(std::declval<const std::string &>())),
+              "push_back propagates throwing copies");
+
+constexpr StaticRingBuffer<int, 32> emptyBuffer;
+static_assert(emptyBuffer.empty() && emptyBuffer.size() == 0 && !emptyBuffer.full(), "usable in constant expressions");
+
+TEST(StaticRingBufferTest, PushPop) {
+    StaticRingBuffer<int, 8> ring;
+    ASSERT_TRUE(ring.empty());
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(ring.push_back(i));
+    }
+    ASSERT_TRUE(ring.full());
+    ASSERT_FALSE(ring.push_back(8));
+    ASSERT_FALSE(ring.push_front(-1));
+
+    for (int round = 0; round < 100; ++round) {
+        ring.pop_front();
+        ASSERT_TRUE(ring.push_back(8 + round));
+        ASSERT_EQ(ring.front(), round + 1);
+        ASSERT_EQ(ring.back(), 8 + round);
+    }
+    for (std::size_t i = 0; i < ring.size(); ++i) {
+        ASSERT_EQ(ring[i], 100 + static_cast<int>(i));
+    }
+
+    ring.clear();
+    ASSERT_TRUE(ring.push_front(1));
+    ASSERT_TRUE(ring.push_front(2));
+    ASSERT_EQ(ring.front(), 2);
+    ASSERT_EQ(ring.back(), 1);
+    ring.pop_back();
+    ring.pop_back();
+    ring.pop_back();
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(StaticRingBufferTest, NonTrivialElements) {
+    std::shared_ptr<int> counter = std::make_shared<int>(0);
+    {
+        StaticRingBuffer<std::shared_ptr<int>, 4> ring;
+        ring.push_back(counter);
+        ring.push_front(counter);
+        ring.push_back(counter);
+        ASSERT_EQ(counter.use_count(), 4);
+        ring.pop_front();
+        ASSERT_EQ(counter.use_count(), 3);
+
+        StaticRingBuffer<std::shared_ptr<int>, 4> copy(ring);
+        ASSERT_EQ(counter.use_count(), 5);
+        copy = ring;
+        ASSERT_EQ(counter.use_count(), 5);
+        copy.clear();
+        ASSERT_EQ(counter.use_count(), 3);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+TEST(StaticRingBufferTest, TimeMeasurement) {
+    const std::size_t n = 100000000;
+    std::uint64_t sumDynamic = 0, sumStatic = 0;
+
+    MEASURE_TIME_BEGIN(dynamicMs);
+    RingBuffer<std::uint64_t> dynamicRing(64);
+    for (std::uint64_t i = 0; i < n; ++i) {
+        dynamicRing.push_back(i);
+        if (dynamicRing.full()) {
+            while (!dynamicRing.empty()) {
+                sumDynamic += dynamicRing.front();
+                dynamicRing.pop_front();
+            }
+        }
+    }
+    MEASURE_TIME_END(dynamicMs);
+
+    MEASURE_TIME_BEGIN(staticMs);
+    StaticRingBuffer<std::uint64_t, 64> staticRing;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        staticRing.push_back(i);
+        if (staticRing.full()) {
+            while (!staticRing.empty()) {
+                sumStatic += staticRing.front();
+                staticRing.pop_front();
+            }
+        }
+    }
+    MEASURE_TIME_END(staticMs);
+
+    ASSERT_EQ(sumDynamic, sumStatic);
+    std::cout   << "RingBuffer time: " << dynamicMs << " ms." << std::endl
+                << "StaticRingBuffer time: " << staticMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(dynamicMs, "RingBuffer", n);
+    MEASURE_PERF_REPORT(staticMs, "StaticRingBuffer", n);
+}
@@ -0,0 +1,169 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+#include <gtest/gtest.h>
+#include <TimingWheel.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#include "Measure.h"
+
+namespace {
+
+// Checks a wheel against a plain map of pending timers.
+template <std::size_t Levels, std::size_t SlotBits>
+void check_against_model(std::uint64_t maxDelay, unsigned seed) {
+    typedef TimingWheel<int, Levels, SlotBits> Wheel;
+    Wheel wheel(5);
+    std::map<int, std::pair<std::uint64_t, typename Wheel::Handle>> pending;
+    std::mt19937_64 gen(seed);
+    int next = 0;
+    std::uint64_t now = 5;
+    for (int round = 0; round < 3000; ++round) {
+        for (int i = gen() % 20; i > 0; --i) {
+            std::uint64_t expiry = now + 1 + gen() % maxDelay;
+            pending[next] = std::make_pair(expiry, wheel.schedule(expiry, next));
+            ++next;
+        }
+        for (int i = gen() % 8; i > 0 && !pending.empty(); --i) {
+            auto it = pending.lower_bound(gen() % next);
+            if (it == pending.end()) {
+                continue;
+            }
+            ASSERT_TRUE(wheel.cancel(it->second.second));
+            ASSERT_FALSE(wheel.cancel(it->second.second));
+            pending.erase(it);
+        }
+        ASSERT_EQ(wheel.size(), pending.size());
+
+        now += gen() % 40;
+        std::vector<int> fired;
+        wheel.advance(now, [&fired](const int *values, std::size_t n) {
+            fired.insert(fired.end(), values, values + n);
+        });
+        std::uint64_t last = 0;
+        for (int id : fired) {
+            auto it = pending.find(id);
+            ASSERT_NE(it, pending.end());
+            ASSERT_LE(it->second.first, now);
+            ASSERT_LE(last, it->second.first);
+            ASSERT_FALSE(wheel.pending(it->second.second));
+            last = it->second.first;
+            pending.erase(it);
+        }
+        for (auto &item : pending) {
+            ASSERT_GT(item.second.first, now);
+            ASSERT_TRUE(wheel.pending(item.second.second));
+        }
+    }
+}
+
+}
+
+TEST(TimingWheelTest, MatchesModel) {
+    check_against_model<4, 8>(5000, 1);
+}
+
+TEST(TimingWheelTest, BeyondHorizon) {
+    // 3 levels of 4 slots cover 64 ticks; later timers are parked.
+    check_against_model<3, 2>(1000, 2);
+}
+
+TEST(TimingWheelTest, PastAndIdle) {
+    TimingWheel<int> wheel(100);
+    auto handle = wheel.schedule(50, 1);
+    ASSERT_EQ(wheel.expiry(handle), 100);
+    int sum = 0;
+    auto add = [&sum](const int *values, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            sum += values[i];
+        }
+    };
+    ASSERT_EQ(wheel.advance(100, add), 1);
+    ASSERT_EQ(sum, 1);
+
+    handle = wheel.schedule(200, 2);
+    ASSERT_TRUE(wheel.cancel(handle));
+    ASSERT_EQ(wheel.advance(1000000000000ull, add), 0);
+    ASSERT_EQ(wheel.now(), 1000000000001ull);
+    wheel.schedule(1000000000300ull, 3);
+    ASSERT_EQ(wheel.advance(1000000000299ull, add), 0);
+    ASSERT_EQ(wheel.advance(1000000000300ull, add), 1);
+    ASSERT_EQ(sum, 4);
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheelTimeTest, TimeMeasurement) {
+    // Connection timeouts: most are cancelled by activity before they fire.
+    const std::size_t timers = 2000000;
+    const std::uint64_t maxTimeout = 30000;
+    std::mt19937_64 gen(7);
+    std::vector<std::uint64_t> timeouts(timers);
+    std::vector<bool> cancelled(timers);
+    for (std::size_t i = 0; i < timers; ++i) {
+        timeouts[i] = 1 + gen() % maxTimeout;
+        cancelled[i] = gen() % 4 != 0;
+    }
+    const std::size_t perTick = 200;
+
+    std::uint64_t wheelFired = 0;
+    MEASURE_TIME_BEGIN(wheelMs);
+    {
+        TimingWheel<std::uint32_t> wheel;
+        std::vector<TimingWheel<std::uint32_t>::Handle> handles(timers);
+        std::uint64_t now = 0;
+        for (std::size_t i = 0; i < timers; ++i) {
+            handles[i] = wheel.schedule(now + timeouts[i], i);
+            if (i >= perTick && cancelled[i - perTick]) {
+                wheel.cancel(handles[i - perTick]);
+            }
+            if (i % perTick == 0) {
+                wheelFired += wheel.advance(++now, [](const std::uint32_t *, std::size_t) {});
+            }
+        }
+        wheelFired += wheel.advance(now + maxTimeout, [](const std::uint32_t *, std::size_t) {});
+    }
+    MEASURE_TIME_END(wheelMs);
+
+    // Heap with lazy deletion, the usual alternative.
+    std::uint64_t heapFired = 0;
+    MEASURE_TIME_BEGIN(heapMs);
+    {
+        typedef std::pair<std::uint64_t, std::uint32_t> Item;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+        std::vector<bool> dead(timers);
+        std::uint64_t now = 0;
+        auto expire = [&](std::uint64_t until) {
+            while (!heap.empty() && heap.top().first <= until) {
+                heapFired += !dead[heap.top().second];
+                dead[heap.top().second] = true;
+                heap.pop();
+            }
+        };
+        for (std::size_t i = 0; i < timers; ++i) {
+            heap.push(Item(now + timeouts[i], i));
+            if (i >= perTick && cancelled[i - perTick] && !dead[i - perTick]) {
+                dead[i - perTick] = true;
+            }
+            if (i % perTick == 0) {
+                expire(++now);
+            }
+        }
+        expire(now + maxTimeout);
+    }
+    MEASURE_TIME_END(heapMs);
+
+    ASSERT_EQ(wheelFired, heapFired);
+    std::cout   << "Timers: " << timers << ", fired: " << wheelFired << std::endl
+                << "TimingWheel time: " << wheelMs << " ms." << std::endl
+                << "priority_queue time: " << heapMs << " ms." << std::endl;
+    MEASURE_PERF_REPORT(wheelMs, "TimingWheel", timers);
+    MEASURE_PERF_REPORT(heapMs, "priority_queue", timers);
+}
@@ -0,0 +1,152 @@
+//
+// Created by xenon on 10/19/26.
+//
+
+// Replays a recorded deque trace against several containers and reports
+// throughput and per-operation latency.
+//
+//   DequeReplay <trace> [repeats]
+//   DequeReplay --synthetic <operations> <trace>   writes a sample trace
+
+#include <DequeTrace.h>
+#include <Deque.h>
+#include <HugePageResource.h>
+#include <MemoryResource.h>
+#include <SmallDeque.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Report {
+    double totalMs;
+    std::uint64_t checksum;
+    bool consistent;
+    std::vector<std::uint32_t> latencies;
+};
+
+// Runs the trace once in full for throughput and once timing every
+// operation; clock reads would otherwise dominate the throughput figure.
+template <class Make>
+Report run(const std::vector<TraceRecord> &records, Make make) {
+    Report report;
+    {
+        auto container = make();
+        auto begin = std::chrono::steady_clock::now();
+        report.checksum = replay_trace(records, container);
+        auto end = std::chrono::steady_clock::now();
+        report.totalMs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / 1e6;
+    }
+    auto container = make();
+    report.latencies.resize(records.size());
+    std::uint64_t checksum = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        checksum = checksum * 31 + apply_trace_record(container, records[i]);
+        auto end = std::chrono::steady_clock::now();
+        report.latencies[i] = static_cast<std::uint32_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    }
+    report.consistent = checksum == report.checksum;
+    return report;
+}
+
+std::uint32_t percentile(const std::vector<std::uint32_t> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+void print(const std::string &name, Report report, std::size_t operations, std::uint64_t expected) {
+    std::sort(report.latencies.begin(), report.latencies.end());
+    std::cout   << std::left << std::setw(22) << name << std::right
+                << std::setw(10) << std::fixed << std::setprecision(2) << report.totalMs
+                << std::setw(10) << operations / report.totalMs / 1000
+                << std::setw(8) << percentile(report.latencies, 0.5)
+                << std::setw(8) << percentile(report.latencies, 0.99)
+                << std::setw(8) << percentile(report.latencies, 0.999)
+                << std::setw(10) << (report.latencies.empty() ? 0 : report.latencies.back())
+                << (report.consistent && report.checksum == expected ? "" : "  CHECKSUM MISMATCH") << std::endl;
+}
+
+// Queue-like traffic with bursts, some stack use at the back and lookups.
+void write_synthetic(std::size_t operations, const std::string &path) {
+    Trace trace;
+    RecordingDeque<std::int64_t> deque(&trace, TRACE_RAW_VALUES);
+    std::mt19937_64 gen(2026);
+    for (std::size_t i = 0; i < operations; ++i) {
+        unsigned op = gen() % 100;
+        if (op < 40) {
+            deque.push_back(static_cast<std::int64_t>(gen() % 1000000));
+        } else if (op < 45) {
+            deque.push_front(static_cast<std::int64_t>(gen() % 1000000));
+        } else if (op < 75 && !deque.empty()) {
+            deque.pop_front();
+        } else if (op < 80 && !deque.empty()) {
+            deque.pop_back();
+        } else if (op < 99 && !deque.empty()) {
+            deque[gen() % deque.size()];
+        } else if (op == 99 && deque.size() < 4096) {
+            deque.for_each([](std::int64_t) {});
+        }
+    }
+    trace.save(path);
+    std::cout << "Wrote " << trace.size() << " operations, " << trace.bytes_size() << " bytes to " << path
+              << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    try {
+        if (argc == 4 && std::string(argv[1]) == "--synthetic") {
+            write_synthetic(std::strtoull(argv[2], nullptr, 10), argv[3]);
+            return 0;
+        }
+        if (argc < 2 || argc > 3) {
+            std::cerr << "Usage: " << argv[0] << " <trace> [repeats]" << std::endl
+                      << "       " << argv[0] << " --synthetic <operations> <trace>" << std::endl;
+            return 2;
+        }
+        int repeats = argc == 3 ? std::atoi(argv[2]) : 1;
+        std::vector<TraceRecord> records = Trace::load(argv[1]).decode();
+        std::cout << "Trace: " << records.size() << " operations" << std::endl;
+
+        std::deque<std::int64_t> reference;
+        std::uint64_t expected = replay_trace(records, reference);
+
+        std::cout   << std::left << std::setw(22) << "container" << std::right
+                    << std::setw(10) << "total ms" << std::setw(10) << "Mops/s"
+                    << std::setw(8) << "p50 ns" << std::setw(8) << "p99 ns"
+                    << std::setw(8) << "p99.9" << std::setw(10) << "max ns" << std::endl;
+        HugePageResource hugePages;
+        for (int i = 0; i < repeats; ++i) {
+            print("Deque", run(records, []() {
+                return Deque<std::int64_t>();
+            }), records.size(), expected);
+            print("std::deque", run(records, []() {
+                return std::deque<std::int64_t>();
+            }), records.size(), expected);
+            print("SmallDeque<16>", run(records, []() {
+                return SmallDeque<std::int64_t, 16>();
+            }), records.size(), expected);
+            print("Deque on huge pages", run(records, [&hugePages]() {
+                return Deque<std::int64_t, PolymorphicAllocator<std::int64_t>>(&hugePages);
+            }), records.size(), expected);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}